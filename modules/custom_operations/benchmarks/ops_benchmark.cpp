@@ -0,0 +1,327 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Throughput of the custom operations. Every benchmark calls evaluate() of a single operation on random data
+// and reports FLOPS (where the operation computes) and the bytes of the tensors it reads and writes per second.
+// Run with --benchmark_filter=<op> to select operations, every case is run with a sweep of thread counts.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <openvino/core/parallel.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/op/parameter.hpp>
+#include <openvino/runtime/tensor.hpp>
+
+#if OV_THREAD == OV_THREAD_TBB || OV_THREAD == OV_THREAD_TBB_AUTO
+#    include <tbb/task_arena.h>
+#endif
+
+#ifdef calculate_grid
+#    include "calculate_grid.hpp"
+#endif
+#ifdef complex_mul
+#    include "complex_mul.hpp"
+#endif
+#ifdef fft
+#    include "fft/fft.hpp"
+#    include "fft/spectral_filter.hpp"
+#endif
+#ifdef grid_sample
+#    include "grid_sample.hpp"
+#endif
+#ifdef sparse_conv
+#    include "sparse_conv/rulebook.hpp"
+#    include "sparse_conv/sparse_conv.hpp"
+#    include "sparse_conv/sparse_conv_transpose.hpp"
+#endif
+#ifdef tokenizer
+#    include "tokenizer/tokenizer.hpp"
+#endif
+
+using namespace TemplateExtension;
+
+namespace {
+
+ov::Tensor random_tensor(const ov::Shape& shape, float lo = -1.0f, float hi = 1.0f, unsigned seed = 0) {
+    ov::Tensor tensor(ov::element::f32, shape);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(lo, hi);
+    float* data = tensor.data<float>();
+    for (size_t i = 0; i < tensor.get_size(); ++i)
+        data[i] = dist(rng);
+    return tensor;
+}
+
+ov::Tensor dims_tensor(const std::vector<int32_t>& dims) {
+    ov::Tensor tensor(ov::element::i32, ov::Shape{dims.size()});
+    std::copy(dims.begin(), dims.end(), tensor.data<int32_t>());
+    return tensor;
+}
+
+std::shared_ptr<ov::Node> parameter(const ov::Tensor& tensor) {
+    return std::make_shared<ov::op::v0::Parameter>(tensor.get_element_type(), tensor.get_shape());
+}
+
+// Output shapes of the real transforms depend on the values of the signal axes
+std::shared_ptr<ov::Node> constant(const ov::Tensor& dims) {
+    const int32_t* data = dims.data<int32_t>();
+    return std::make_shared<ov::op::v0::Constant>(ov::element::i32, dims.get_shape(),
+                                                  std::vector<int32_t>(data, data + dims.get_size()));
+}
+
+// Points at random voxel centers of a cube, about a third of the voxels are occupied
+ov::Tensor random_points(size_t numPoints, unsigned seed) {
+    const float extent = std::ceil(std::cbrt(numPoints * 3.0f));
+    ov::Tensor points = random_tensor({numPoints, 3}, 0.0f, extent, seed);
+    float* data = points.data<float>();
+    for (size_t i = 0; i < points.get_size(); ++i)
+        data[i] = std::floor(data[i]) + 0.5f;
+    return points;
+}
+
+// 1, 2, 4, ... threads up to the hardware concurrency, which is included as well
+void thread_counts(std::vector<int64_t>& threads) {
+    const int64_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int64_t t = 1; t < maxThreads; t *= 2)
+        threads.push_back(t);
+    threads.push_back(maxThreads);
+}
+
+// The first argument of every case is the number of threads, the others are the sizes of the operation
+void add_cases(benchmark::internal::Benchmark* bench,
+               const std::vector<std::string>& names,
+               const std::vector<std::vector<int64_t>>& sizes) {
+    std::vector<int64_t> threads;
+    thread_counts(threads);
+    for (const auto& size : sizes) {
+        for (int64_t t : threads) {
+            std::vector<int64_t> args{t};
+            args.insert(args.end(), size.begin(), size.end());
+            bench->Args(args);
+        }
+    }
+    std::vector<std::string> argNames{"threads"};
+    argNames.insert(argNames.end(), names.begin(), names.end());
+    bench->ArgNames(argNames)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+// Evaluates the node in a task arena of the requested number of threads and sets the counters
+void run(benchmark::State& state,
+         const ov::Node& node,
+         const ov::TensorVector& inputs,
+         ov::TensorVector& outputs,
+         double flops,
+         double bytes) {
+    const int threads = static_cast<int>(state.range(0));
+    auto evaluate = [&]() {
+        node.evaluate(outputs, inputs);
+    };
+#if OV_THREAD == OV_THREAD_TBB || OV_THREAD == OV_THREAD_TBB_AUTO
+    tbb::task_arena arena(threads);
+    for (auto _ : state)
+        arena.execute(evaluate);
+#else
+    // The thread count is fixed by the threading runtime
+    (void)threads;
+    for (auto _ : state)
+        evaluate();
+#endif
+    if (flops > 0)
+        state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+}
+
+size_t byte_size(const ov::TensorVector& tensors) {
+    size_t size = 0;
+    for (const auto& tensor : tensors)
+        size += tensor.get_byte_size();
+    return size;
+}
+
+#ifdef fft
+// Complex 2D transforms of a batch of N x N signals: {batch, N}. Non power-of-two lengths take the mixed-radix
+// and Bluestein paths of the engine.
+const std::vector<std::vector<int64_t>> fft_sizes = {{64, 64}, {16, 256}, {4, 1024}, {64, 60}, {64, 67}};
+
+double fft_flops(size_t batch, size_t n) {
+    // Conventional 5 N log2 N estimate of a complex transform
+    return 5.0 * batch * n * n * std::log2(static_cast<double>(n * n));
+}
+
+void fft_2d(benchmark::State& state) {
+    const size_t batch = state.range(1), n = state.range(2);
+    ov::TensorVector inputs{random_tensor({batch, n, n, 2}), dims_tensor({1, 2})};
+    FFT op({parameter(inputs[0]), constant(inputs[1])}, false, false);
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, inputs[0].get_shape())};
+    run(state, op, inputs, outputs, fft_flops(batch, n), byte_size(inputs) + byte_size(outputs));
+}
+BENCHMARK(fft_2d)->Name("FFT")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"batch", "n"}, fft_sizes);
+});
+
+void rfft_2d(benchmark::State& state) {
+    const size_t batch = state.range(1), n = state.range(2);
+    ov::TensorVector inputs{random_tensor({batch, n, n}), dims_tensor({1, 2})};
+    RFFT op({parameter(inputs[0]), constant(inputs[1])});
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, op.get_output_shape(0))};
+    run(state, op, inputs, outputs, fft_flops(batch, n) / 2, byte_size(inputs) + byte_size(outputs));
+}
+BENCHMARK(rfft_2d)->Name("RFFT")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"batch", "n"}, fft_sizes);
+});
+
+void spectral_filter_2d(benchmark::State& state) {
+    const size_t batch = state.range(1), n = state.range(2);
+    ov::TensorVector inputs{random_tensor({batch, n, n, 2}), dims_tensor({1, 2}), random_tensor({n, n, 2})};
+    SpectralFilter op({parameter(inputs[0]), constant(inputs[1]), parameter(inputs[2])}, false);
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, inputs[0].get_shape())};
+    run(state, op, inputs, outputs, 2 * fft_flops(batch, n) + 6.0 * batch * n * n,
+        byte_size(inputs) + byte_size(outputs));
+}
+BENCHMARK(spectral_filter_2d)->Name("SpectralFilter")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"batch", "n"}, fft_sizes);
+});
+#endif
+
+#ifdef complex_mul
+// {batch, channels, H = W, broadcast}: the second input has a single channel if broadcast is set
+void complex_multiplication(benchmark::State& state) {
+    const size_t batch = state.range(1), channels = state.range(2), size = state.range(3);
+    const bool broadcast = state.range(4) != 0;
+    ov::TensorVector inputs{random_tensor({batch, channels, size, size, 2}, -1.0f, 1.0f, 0),
+                            random_tensor({batch, broadcast ? 1 : channels, size, size, 2}, -1.0f, 1.0f, 1)};
+    ComplexMultiplication op({parameter(inputs[0]), parameter(inputs[1])});
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, inputs[0].get_shape())};
+    run(state, op, inputs, outputs, 6.0 * batch * channels * size * size, byte_size(inputs) + byte_size(outputs));
+}
+BENCHMARK(complex_multiplication)->Name("ComplexMultiplication")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"batch", "channels", "size", "broadcast"}, {{1, 16, 64, 0}, {4, 32, 128, 0}, {4, 32, 128, 1}, {1, 8, 512, 1}});
+});
+#endif
+
+#ifdef grid_sample
+// {batch, channels, H = W of both the input and the output}
+void grid_sampling(benchmark::State& state) {
+    const size_t batch = state.range(1), channels = state.range(2), size = state.range(3);
+    ov::TensorVector inputs{random_tensor({batch, channels, size, size}, -1.0f, 1.0f, 0),
+                            random_tensor({batch, size, size, 2}, -1.1f, 1.1f, 1)};
+    GridSample op({parameter(inputs[0]), parameter(inputs[1])});
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, {batch, channels, size, size})};
+    // Four multiplications and three additions per output element, the taps are shared by the channels
+    run(state, op, inputs, outputs, 7.0 * outputs[0].get_size(), byte_size(inputs) + byte_size(outputs));
+}
+BENCHMARK(grid_sampling)->Name("GridSample")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"batch", "channels", "size"}, {{1, 32, 64}, {4, 32, 128}, {1, 16, 512}});
+});
+#endif
+
+#ifdef calculate_grid
+// {number of points}
+void grid_calculation(benchmark::State& state) {
+    const size_t numPoints = state.range(1);
+    ov::TensorVector inputs{random_tensor({numPoints, 3}, 0.0f, std::cbrt(numPoints * 8.0f))};
+    CalculateGrid op(parameter(inputs[0]));
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, inputs[0].get_shape())};
+    run(state, op, inputs, outputs, 0, byte_size(inputs) + byte_size(outputs));
+    state.SetItemsProcessed(static_cast<int64_t>(numPoints * state.iterations()));
+}
+BENCHMARK(grid_calculation)->Name("CalculateGrid")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"points"}, {{10000}, {100000}, {1000000}});
+});
+#endif
+
+#ifdef sparse_conv
+// {number of points, input channels, output channels, kernel size}. Output points are the input ones, like in
+// the submanifold layers of Open3D networks. Repeated evaluations reuse the cached rulebook as consecutive
+// layers of a network do, so the numbers show the steady state throughput of the GEMMs.
+template <typename Op>
+void sparse_conv_case(benchmark::State& state, bool transpose) {
+    const size_t numPoints = state.range(1), IC = state.range(2), OC = state.range(3), k = state.range(4);
+    ov::TensorVector inputs{random_tensor({numPoints, IC}, -1.0f, 1.0f, 0),
+                            random_points(numPoints, 1),
+                            random_points(numPoints, 1),
+                            random_tensor({k, k, k, IC, OC}, -1.0f, 1.0f, 2),
+                            ov::Tensor(ov::element::f32, {3})};
+    std::fill_n(inputs[4].data<float>(), 3, 0.0f);
+    ov::OutputVector args;
+    for (const auto& tensor : inputs)
+        args.push_back(parameter(tensor));
+    Op op(args);
+    ov::TensorVector outputs{ov::Tensor(ov::element::f32, {numPoints, OC})};
+
+    const auto rules = get_rulebook(inputs[1].data<float>(), numPoints, inputs[2].data<float>(), numPoints,
+                                    inputs[4].data<float>(), static_cast<int>(k), static_cast<int>(k),
+                                    static_cast<int>(k), transpose);
+    const double pairs = static_cast<double>(rules->inputs.size());
+    run(state, op, inputs, outputs, 2.0 * pairs * IC * OC,
+        pairs * IC * sizeof(float) + inputs[3].get_byte_size() + outputs[0].get_byte_size());
+    state.counters["pairs"] = pairs;
+}
+
+const std::vector<std::string> sparse_conv_args = {"points", "ic", "oc", "kernel"};
+const std::vector<std::vector<int64_t>> sparse_conv_sizes = {{10000, 16, 16, 3},
+                                                             {100000, 32, 32, 3},
+                                                             {100000, 64, 64, 3},
+                                                             {20000, 32, 32, 5}};
+
+void sparse_convolution(benchmark::State& state) {
+    sparse_conv_case<SparseConv>(state, false);
+}
+BENCHMARK(sparse_convolution)->Name("SparseConv")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, sparse_conv_args, sparse_conv_sizes);
+});
+
+void sparse_convolution_transpose(benchmark::State& state) {
+    sparse_conv_case<SparseConvTranspose>(state, true);
+}
+BENCHMARK(sparse_convolution_transpose)->Name("SparseConvTranspose")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, sparse_conv_args, sparse_conv_sizes);
+});
+#endif
+
+#ifdef tokenizer
+// {batch, words per string}: WordPiece with a vocabulary of random words and as many continuations of them.
+// Every word of the text is a word of the vocabulary followed by a continuation.
+void tokenization(benchmark::State& state) {
+    const size_t batch = state.range(1), words = state.range(2);
+    std::mt19937 rng(0);
+    std::vector<std::string> vocab{"[UNK]"};
+    for (size_t i = 0; i < 8000; ++i) {
+        std::string word(3 + rng() % 8, 'a');
+        for (auto& c : word)
+            c = static_cast<char>('a' + rng() % 26);
+        vocab.push_back(i % 2 ? "##" + word : word);
+    }
+    std::vector<std::string> texts(batch);
+    for (auto& text : texts) {
+        for (size_t w = 0; w < words; ++w)
+            text += vocab[1 + 2 * (rng() % 4000)] + vocab[2 + 2 * (rng() % 4000)].substr(2) + " ";
+    }
+
+    ov::TensorVector inputs{ov::Tensor(ov::element::u8, {0}), ov::Tensor(ov::element::u8, {0})};
+    openvino_extensions::pack_strings(texts, inputs[0]);
+    openvino_extensions::pack_strings(vocab, inputs[1]);
+    TokenizerAttrs attrs;
+    attrs.mode = "wordpiece";
+    attrs.unk_token = "[UNK]";
+    Tokenizer op({parameter(inputs[0]), parameter(inputs[1])}, attrs);
+    ov::TensorVector outputs{ov::Tensor(ov::element::i32, {batch, 2 * words}),
+                             ov::Tensor(ov::element::i32, {batch, 2 * words})};
+    run(state, op, inputs, outputs, 0, inputs[0].get_byte_size() + byte_size(outputs));
+    state.SetItemsProcessed(static_cast<int64_t>(batch * state.iterations()));
+}
+BENCHMARK(tokenization)->Name("Tokenizer")->Apply([](benchmark::internal::Benchmark* b) {
+    add_cases(b, {"batch", "words"}, {{64, 32}, {256, 128}, {1024, 512}});
+});
+#endif
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -11,6 +11,10 @@ class ComplexMul(torch.autograd.Function):
 
     @staticmethod
     def forward(self, input_tensor, other_tensor):
+        # Half precision inputs are multiplied in f32 and rounded back, as the extension does
+        dtype = input_tensor.dtype
+        input_tensor = input_tensor.float()
+        other_tensor = other_tensor.float()
         complex_index = -1
         real_part = input_tensor[..., 0] * other_tensor[..., 0] - input_tensor[..., 1] * other_tensor[..., 1]
         imaginary_part = input_tensor[..., 0] * other_tensor[..., 1] + input_tensor[..., 1] * other_tensor[..., 0]
@@ -22,4 +26,4 @@ class ComplexMul(torch.autograd.Function):
             ],
             dim=complex_index,
         )
-        return multiplication
+        return multiplication.to(dtype)
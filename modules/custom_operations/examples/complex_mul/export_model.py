@@ -16,13 +16,13 @@ class MyModel(nn.Module):
     def forward(self, x, y):
         return self.complex_mul.apply(x, y)
 
-def export(inp_shape=[3, 2, 4, 8, 2], other_shape=[3, 2, 4, 8, 2]):
+def export(inp_shape=[3, 2, 4, 8, 2], other_shape=[3, 2, 4, 8, 2], dtype='float32'):
     np.random.seed(324)
     torch.manual_seed(32)
 
     model = MyModel()
-    inp = Variable(torch.randn(inp_shape))
-    inp1 = Variable(torch.randn(other_shape))
+    inp = Variable(torch.randn(inp_shape).to(getattr(torch, dtype)))
+    inp1 = Variable(torch.randn(other_shape).to(getattr(torch, dtype)))
     model.eval()
 
     with torch.no_grad():
@@ -31,14 +31,16 @@ def export(inp_shape=[3, 2, 4, 8, 2], other_shape=[3, 2, 4, 8, 2]):
                         output_names=['output'],
                         operator_export_type=torch.onnx.OperatorExportTypes.ONNX_ATEN_FALLBACK)
 
+    # NumPy has no bfloat16, the data is returned in f32
     ref = model(inp, inp1)
-    return [inp.detach().numpy(), inp1.detach().numpy()], ref.detach().numpy()
+    return [inp.detach().float().numpy(), inp1.detach().float().numpy()], ref.detach().float().numpy()
 
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
     parser.add_argument('--inp_shape', type=int, nargs='+', default=[3, 2, 4, 8, 2])
     parser.add_argument('--other_shape', type=int, nargs='+', default=[3, 2, 4, 8, 2])
+    parser.add_argument('--dtype', type=str, default='float32', choices=['float32', 'float16', 'bfloat16'])
     args = parser.parse_args()
 
-    export(args.inp_shape, args.other_shape)
+    export(args.inp_shape, args.other_shape, args.dtype)
@@ -6,27 +6,30 @@ import argparse
 import torch
 import torch.nn as nn
 from torch.autograd import Variable
-from .fft import FFT
+from .fft import FFT, RFFT
 
 
 class MyModel(nn.Module):
-    def __init__(self, inverse, centered, dims):
+    def __init__(self, inverse, centered, dims, real):
         super(MyModel, self).__init__()
         self.inverse = inverse
         self.centered = centered
         self.dims = dims
-        self.fft = FFT()
+        self.real = real
+        self.fft = RFFT() if real else FFT()
 
     def forward(self, x):
+        if self.real:
+            return self.fft.apply(x, self.inverse, self.dims)
         return self.fft.apply(x, self.inverse, self.centered, self.dims)
 
 
-def export(shape, inverse, centered, dims):
+def export(shape, inverse, centered, dims, real=False, dtype='float32'):
     np.random.seed(324)
     torch.manual_seed(32)
 
-    model = MyModel(inverse, centered, dims)
-    inp = Variable(torch.randn(shape))
+    model = MyModel(inverse, centered, dims, real)
+    inp = Variable(torch.randn(shape).to(getattr(torch, dtype)))
     model.eval()
 
     with torch.no_grad():
@@ -35,8 +38,9 @@ def export(shape, inverse, centered, dims):
                           output_names=['output'],
                           operator_export_type=torch.onnx.OperatorExportTypes.ONNX_FALLTHROUGH)
 
+    # NumPy has no bfloat16, the data is returned in f32
     ref = model(inp)
-    return [inp.detach().numpy()], ref.detach().numpy()
+    return [inp.detach().float().numpy()], ref.detach().float().numpy()
 
 
 if __name__ == '__main__':
@@ -45,5 +49,7 @@ if __name__ == '__main__':
     parser.add_argument('--inverse', action='store_true')
     parser.add_argument('--centered', action='store_true')
     parser.add_argument('--dims', type=int, nargs='+', default=[2, 3])
+    parser.add_argument('--real', action='store_true')
+    parser.add_argument('--dtype', type=str, default='float32', choices=['float32', 'float16', 'bfloat16'])
     args = parser.parse_args()
-    export(args.shape, args.inverse, args.centered, args.dims)
+    export(args.shape, args.inverse, args.centered, args.dims, args.real, args.dtype)
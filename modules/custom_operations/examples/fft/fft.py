@@ -55,6 +55,10 @@ class FFT(torch.autograd.Function):
 
     @staticmethod
     def forward(self, x, inverse, centered, dims):
+        # Half precision inputs are transformed in f32 and rounded back, as the extension does
+        dtype = x.dtype
+        x = x.float()
+
         # https://pytorch.org/docs/stable/torch.html#torch.fft
         if centered:
             x = ifftshift(x, dims)
@@ -73,4 +77,21 @@ class FFT(torch.autograd.Function):
         if centered:
             y = fftshift(y, dims)
 
-        return y
+        return y.to(dtype)
+
+
+class RFFT(torch.autograd.Function):
+    @staticmethod
+    def symbolic(g, x, inverse, dims):
+        dims = torch.tensor(dims)
+        dims = g.op("Constant", value_t=dims)
+
+        return g.op('IRFFT' if inverse else 'RFFT', x, dims)
+
+    @staticmethod
+    def forward(self, x, inverse, dims):
+        dtype = x.dtype
+        x = x.float()
+        if inverse:
+            return torch.fft.irfftn(torch.view_as_complex(x), dim=dims, norm="ortho").to(dtype)
+        return torch.view_as_real(torch.fft.rfftn(x, dim=dims, norm="ortho")).to(dtype)
@@ -0,0 +1,47 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import argparse
+import torch
+import torch.nn as nn
+from .grid_sample import GridSample
+
+class MyModel(nn.Module):
+    def __init__(self, padding_mode):
+        super(MyModel, self).__init__()
+        self.grid_sample = GridSample()
+        self.padding_mode = padding_mode
+
+    def forward(self, x, grid):
+        return self.grid_sample.apply(x, grid, self.padding_mode)
+
+def export(inp_shape=[2, 3, 5, 7], out_size=[6, 9], padding_mode='zeros', grid_scale=1.0):
+    np.random.seed(324)
+    torch.manual_seed(32)
+
+    model = MyModel(padding_mode)
+    inp = torch.randn(inp_shape)
+    # Scales above 1 move a part of the sampling points outside of the input
+    grid = (torch.rand([inp_shape[0]] + out_size + [2]) * 2 - 1) * grid_scale
+    model.eval()
+
+    with torch.no_grad():
+        torch.onnx.export(model, (inp, grid), 'model.onnx',
+                          input_names=['input', 'input1'],
+                          output_names=['output'],
+                          operator_export_type=torch.onnx.OperatorExportTypes.ONNX_FALLTHROUGH)
+
+    ref = model(inp, grid)
+    return [inp.detach().numpy(), grid.detach().numpy()], ref.detach().numpy()
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
+    parser.add_argument('--inp_shape', type=int, nargs='+', default=[2, 3, 5, 7])
+    parser.add_argument('--out_size', type=int, nargs='+', default=[6, 9])
+    parser.add_argument('--padding_mode', type=str, default='zeros', choices=['zeros', 'border', 'reflection'])
+    parser.add_argument('--grid_scale', type=float, default=1.0)
+    args = parser.parse_args()
+
+    export(args.inp_shape, args.out_size, args.padding_mode, args.grid_scale)
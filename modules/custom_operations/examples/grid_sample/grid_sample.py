@@ -0,0 +1,14 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import torch
+import torch.nn.functional as F
+
+class GridSample(torch.autograd.Function):
+    @staticmethod
+    def symbolic(g, inp, grid, padding_mode):
+        return g.op("GridSample", inp, grid, padding_mode_s=padding_mode)
+
+    @staticmethod
+    def forward(self, inp, grid, padding_mode):
+        return F.grid_sample(inp, grid, mode='bilinear', padding_mode=padding_mode, align_corners=True)
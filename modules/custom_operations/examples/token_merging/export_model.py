@@ -0,0 +1,82 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import argparse
+import os
+import sys
+import torch
+import torch.nn as nn
+
+# The operations are exported by tomeov of modules/token_merging, so the definitions of this tree are tested
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'token_merging'))
+from tomeov.merge import ToMeMerge, ToMeUnmerge
+
+
+class MyModel(nn.Module):
+    def __init__(self, r, class_token, distill_token):
+        super(MyModel, self).__init__()
+        self.r = r
+        self.class_token = class_token
+        self.distill_token = distill_token
+
+    def forward(self, x, metric, size):
+        return ToMeMerge.apply(x, metric, size, self.r, self.class_token, self.distill_token)
+
+
+class MyUnmergeModel(nn.Module):
+    def forward(self, x, token_idx, dst_idx, residual):
+        return ToMeUnmerge.apply(x, token_idx, dst_idx, residual)
+
+
+def export(shape=[2, 197, 64], metric_channels=32, r=16, class_token=True, distill_token=False):
+    np.random.seed(324)
+    torch.manual_seed(32)
+
+    model = MyModel(r, class_token, distill_token)
+    x = torch.randn(shape)
+    metric = torch.randn(shape[:2] + [metric_channels])
+    size = torch.randint(1, 4, shape[:2] + [1]).float()
+    model.eval()
+
+    with torch.no_grad():
+        torch.onnx.export(model, (x, metric, size), 'model.onnx',
+                          input_names=['input', 'input1', 'input2'],
+                          output_names=['output', 'output1'],
+                          operator_export_type=torch.onnx.OperatorExportTypes.ONNX_FALLTHROUGH)
+
+    ref = model(x, metric, size)
+    return [x.numpy(), metric.numpy(), size.numpy()], [ref[0].detach().numpy(), ref[1].detach().numpy()]
+
+
+def export_unmerge(shape=[2, 4096, 320], r=2048):
+    np.random.seed(324)
+    torch.manual_seed(32)
+
+    batch, tokens, channels = shape
+    model = MyUnmergeModel()
+    x = torch.randn([batch, tokens - r, channels])
+    token_idx = torch.rand(batch, tokens, 1).argsort(dim=1)
+    dst_idx = torch.randint(0, tokens - r, [batch, r, 1])
+    residual = torch.randn(shape)
+    model.eval()
+
+    with torch.no_grad():
+        torch.onnx.export(model, (x, token_idx, dst_idx, residual), 'model.onnx',
+                          input_names=['input', 'input1', 'input2', 'input3'],
+                          output_names=['output'],
+                          operator_export_type=torch.onnx.OperatorExportTypes.ONNX_FALLTHROUGH)
+
+    ref = model(x, token_idx, dst_idx, residual)
+    return [x.numpy(), token_idx.numpy(), dst_idx.numpy(), residual.numpy()], ref.detach().numpy()
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
+    parser.add_argument('--shape', type=int, nargs='+', default=[2, 197, 64])
+    parser.add_argument('--metric_channels', type=int, default=32)
+    parser.add_argument('--r', type=int, default=16)
+    parser.add_argument('--class_token', action='store_true')
+    parser.add_argument('--distill_token', action='store_true')
+    args = parser.parse_args()
+    export(args.shape, args.metric_channels, args.r, args.class_token, args.distill_token)
@@ -0,0 +1,75 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import argparse
+import os
+from openvino.runtime import Model, serialize
+from openvino.runtime import opset8 as ops
+from openvino.runtime.utils.node_factory import NodeFactory
+
+
+# Same layout as openvino_extensions::pack_strings: batch size, offsets and the UTF-8 symbols
+def pack_strings(strings):
+    symbols = [s.encode('utf-8') for s in strings]
+    offsets = np.cumsum([0] + [len(s) for s in symbols], dtype=np.int32)
+    header = np.concatenate(([len(symbols)], offsets)).astype(np.int32)
+    return np.frombuffer(header.tobytes() + b''.join(symbols), dtype=np.uint8)
+
+
+# The word of 60 two-byte characters is within the limit of 100 characters per word
+WORDPIECE_VOCAB = ['[PAD]', '[UNK]', 'hello', 'world', '##s', 'un', '##aff', '##able', ',', '!', '\u00e9', '##\u00e9']
+WORDPIECE_TEXTS = ['Hello, worlds!', 'unaffable xyz', '', '\u00e9' * 60]
+WORDPIECE_IDS = [[2, 8, 3, 4, 9], [5, 6, 7, 1], [], [10] + [11] * 59]
+
+BPE_VOCAB = ['<unk>', 'l', 'o', 'w', 'e', 'r', 'n', 's', 't', 'lo', 'low', 'er', 'lower']
+BPE_MERGES = ['l o', 'lo w', 'e r', 'low er']
+BPE_TEXTS = ['lower low newest', 'z lo']
+BPE_IDS = [[12, 10, 6, 4, 3, 4, 7, 8], [0, 9]]
+
+# SentencePiece BPE marks the start of every word with U+2581
+SP_VOCAB = ['<unk>', '\u2581', 'l', 'o', 'w', 'e', 'r', '\u2581l', '\u2581lo', '\u2581low', 'er', '\u2581lower']
+SP_MERGES = ['\u2581 l', '\u2581l o', '\u2581lo w', 'e r', '\u2581low er']
+SP_TEXTS = ['lower  low', 'rl']
+SP_IDS = [[11, 9], [1, 6, 2]]
+
+
+def export(mode, max_length=0):
+    factory = NodeFactory()
+    factory.add_extension(os.getenv('CUSTOM_OP_LIB'))
+
+    if mode == 'wordpiece':
+        vocab, merges, texts, ids = WORDPIECE_VOCAB, None, WORDPIECE_TEXTS, WORDPIECE_IDS
+        attrs = {'mode': 'wordpiece', 'unk_token': '[UNK]', 'lowercase': True}
+    elif mode == 'sentencepiece':
+        vocab, merges, texts, ids = SP_VOCAB, SP_MERGES, SP_TEXTS, SP_IDS
+        attrs = {'mode': 'bpe', 'unk_token': '<unk>', 'word_prefix': '\u2581'}
+    else:
+        vocab, merges, texts, ids = BPE_VOCAB, BPE_MERGES, BPE_TEXTS, BPE_IDS
+        attrs = {'mode': 'bpe', 'unk_token': '<unk>'}
+    attrs['max_length'] = max_length
+
+    inp = ops.parameter([-1], np.uint8, name='input')
+    args = [inp, ops.constant(pack_strings(vocab))]
+    if merges is not None:
+        args.append(ops.constant(pack_strings(merges)))
+    tokenizer = factory.create('Tokenizer', args, attrs)
+    serialize(Model(tokenizer.outputs(), [inp]), 'model.xml')
+
+    # Sequences are truncated and padded to max_length or to the longest one
+    length = max_length if max_length > 0 else max(len(seq) for seq in ids)
+    ref_ids = np.zeros([len(ids), length], dtype=np.int32)
+    ref_mask = np.zeros([len(ids), length], dtype=np.int32)
+    for i, seq in enumerate(ids):
+        seq = seq[:length]
+        ref_ids[i, :len(seq)] = seq
+        ref_mask[i, :len(seq)] = 1
+    return [pack_strings(texts)], [ref_ids, ref_mask]
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generate OpenVINO model and test data')
+    parser.add_argument('--mode', choices=['bpe', 'sentencepiece', 'wordpiece'], default='wordpiece')
+    parser.add_argument('--max_length', type=int, default=0)
+    args = parser.parse_args()
+    export(args.mode, args.max_length)
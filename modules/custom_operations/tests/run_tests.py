@@ -2,7 +2,9 @@
 # SPDX-License-Identifier: Apache-2.0
 
 from openvino import Core
+from openvino import Type
 from openvino import convert_model
+from openvino.preprocess import PrePostProcessor
 
 import pytest
 import numpy as np
@@ -25,43 +27,119 @@ def run_test(ref_inputs, ref_res, test_onnx=False, threshold=1e-5):
     net = core.read_model('model.onnx') if test_onnx else convert_model('model.onnx', extension=ext_path)
 
     net.reshape(shapes)
+
+    # NumPy has no bfloat16, so half precision models are given and return f32 tensors
+    half_types = [Type.f16, Type.bf16]
+    if any(port.get_element_type() in half_types for port in net.inputs + net.outputs):
+        ppp = PrePostProcessor(net)
+        for i, port in enumerate(net.inputs):
+            if port.get_element_type() in half_types:
+                ppp.input(i).tensor().set_element_type(Type.f32)
+        for i, port in enumerate(net.outputs):
+            if port.get_element_type() in half_types:
+                ppp.output(i).tensor().set_element_type(Type.f32)
+        net = ppp.build()
+
     compiled_model = core.compile_model(net, 'CPU')
 
     out = compiled_model(inputs)
-    out = next(iter(out.values()))
 
-    assert ref_res.shape == out.shape
-    diff = np.max(np.abs(ref_res - out))
-    assert diff <= threshold
+    # A list of references is compared with the outputs in order
+    refs = ref_res if isinstance(ref_res, list) else [ref_res]
+    for i, ref in enumerate(refs):
+        res = out[compiled_model.output(i)]
+        assert ref.shape == res.shape
+        diff = np.max(np.abs(ref - res))
+        assert diff <= threshold
+
+    return net
+
+
+# Half precision transforms round every pass over the signal axes, the reference is rounded once
+HALF_THRESHOLDS = {"float16": 1e-2, "bfloat16": 1e-1}
 
 
 @pytest.mark.parametrize("shape", [[5, 120, 2], [4, 240, 320, 2], [3, 16, 240, 320, 2], [4, 5, 16, 31, 2]])
 @pytest.mark.parametrize("inverse", [False, True])
 @pytest.mark.parametrize("centered", [False, True])
 @pytest.mark.parametrize("test_onnx", [False, True])
+@pytest.mark.parametrize("dims", [[1], [1, 2], [2, 3], [0, 2]])
+@pytest.mark.parametrize("dtype", ["float32", "float16", "bfloat16"])
+def test_fft(shape, inverse, centered, test_onnx, dims, dtype):
+    from examples.fft.export_model import export
+
+    if max(dims) >= len(shape) - 1:
+        pytest.skip("unsupported configuration")
+
+    inp, ref = export(shape, inverse, centered, dims, dtype=dtype)
+    run_test(inp, ref, test_onnx=test_onnx, threshold=HALF_THRESHOLDS.get(dtype, 1e-5))
+
+
+@pytest.mark.parametrize("shape", [[5, 120], [4, 240, 320], [3, 16, 240, 321]])
+@pytest.mark.parametrize("inverse", [False, True])
+@pytest.mark.parametrize("test_onnx", [False, True])
 @pytest.mark.parametrize("dims", [[1], [1, 2], [2, 3]])
-def test_fft(shape, inverse, centered, test_onnx, dims):
+@pytest.mark.parametrize("dtype", ["float32", "float16", "bfloat16"])
+def test_rfft(shape, inverse, test_onnx, dims, dtype):
     from examples.fft.export_model import export
 
-    if len(shape) == 3 and dims != [1] or \
-       len(shape) == 4 and dims == [2, 3] or \
-       len(shape) == 5 and dims == [1] or \
-       centered and len(dims) != 2:
+    if max(dims) >= len(shape):
         pytest.skip("unsupported configuration")
 
-    inp, ref = export(shape, inverse, centered, dims)
-    run_test(inp, ref, test_onnx=test_onnx)
+    # Inverse transform takes a half-spectrum of complex numbers
+    if inverse:
+        shape = shape + [2]
 
+    inp, ref = export(shape, inverse, False, dims, real=True, dtype=dtype)
+    run_test(inp, ref, test_onnx=test_onnx, threshold=HALF_THRESHOLDS.get(dtype, 1e-5))
 
-@pytest.mark.parametrize("shape", [[3, 2, 4, 8, 2], [3, 1, 4, 8, 2]])
+
+# Either input or both of them on different axes are broadcasted
+@pytest.mark.parametrize("inp_shape,other_shape", [([3, 2, 4, 8, 2], [3, 2, 4, 8, 2]),
+                                                   ([3, 2, 4, 8, 2], [3, 1, 4, 8, 2]),
+                                                   ([3, 2, 4, 8, 2], [1, 2, 1, 8, 2]),
+                                                   ([3, 2, 4, 8, 2], [8, 2]),
+                                                   ([3, 1, 4, 8, 2], [3, 2, 4, 8, 2]),
+                                                   ([8, 2], [3, 2, 4, 8, 2]),
+                                                   ([1, 2, 1, 8, 2], [3, 1, 4, 8, 2]),
+                                                   ([3, 1, 70, 2], [1, 90, 1, 2])])
 @pytest.mark.parametrize("test_onnx", [False, True])
-def test_complex_mul(shape, test_onnx):
+@pytest.mark.parametrize("dtype", ["float32", "float16", "bfloat16"])
+def test_complex_mul(inp_shape, other_shape, test_onnx, dtype):
     from examples.complex_mul.export_model import export
 
-    inp, ref = export(other_shape=shape)
+    inp, ref = export(inp_shape, other_shape, dtype=dtype)
+    run_test(inp, ref, test_onnx=test_onnx, threshold=HALF_THRESHOLDS.get(dtype, 1e-5))
+
+
+# Grid scale 3 puts most of the sampling points outside of the input
+@pytest.mark.parametrize("inp_shape", [[2, 3, 5, 7], [1, 2, 1, 9], [1, 2, 6, 1], [1, 1, 1, 1]])
+@pytest.mark.parametrize("padding_mode", ["zeros", "border", "reflection"])
+@pytest.mark.parametrize("grid_scale", [1.0, 3.0])
+@pytest.mark.parametrize("test_onnx", [False, True])
+def test_grid_sample(inp_shape, padding_mode, grid_scale, test_onnx):
+    from examples.grid_sample.export_model import export
+
+    inp, ref = export(inp_shape, [6, 19], padding_mode, grid_scale)
     run_test(inp, ref, test_onnx=test_onnx)
 
 
+@pytest.mark.parametrize("filter_shape", [[3, 4, 16, 20, 2], [16, 20, 2], [4, 1, 20, 2]])
+@pytest.mark.parametrize("centered", [False, True])
+@pytest.mark.parametrize("test_onnx", [False, True])
+def test_spectral_filter(filter_shape, centered, test_onnx):
+    from examples.spectral_filter.export_model import export
+
+    inp, ref = export([3, 4, 16, 20, 2], filter_shape, centered, [2, 3])
+    net = run_test(inp, ref, test_onnx=test_onnx, threshold=1e-4)
+
+    # The unfused chain gives the same result, so check that the model has been fused
+    op_types = [op.get_type_name() for op in net.get_ops()]
+    assert 'SpectralFilter' in op_types
+    assert 'FFT' not in op_types
+    assert 'ComplexMultiplication' not in op_types
+
+
 @pytest.mark.parametrize("in_channels", [1, 3])
 @pytest.mark.parametrize("filters", [1, 4])
 @pytest.mark.parametrize("kernel_size", [[3, 3, 3], [5, 5, 5], [2, 2, 2]])
@@ -90,3 +168,41 @@ def test_calculate_grid():
     from examples.calculate_grid.export_model import export
     inp, ref = export(num_points=10, max_grid_extent=5)
     run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("shape", [[2, 197, 64], [1, 50, 16]])
+@pytest.mark.parametrize("r", [0, 16, 40])
+@pytest.mark.parametrize("class_token", [False, True])
+@pytest.mark.parametrize("distill_token", [False, True])
+@pytest.mark.parametrize("test_onnx", [False, True])
+def test_tome_merge(shape, r, class_token, distill_token, test_onnx):
+    from examples.token_merging.export_model import export
+
+    inp, ref = export(shape, 32, r, class_token, distill_token)
+    run_test(inp, ref, test_onnx=test_onnx)
+
+
+@pytest.mark.parametrize("shape", [[2, 4096, 320], [1, 1024, 64]])
+@pytest.mark.parametrize("r", [1, 300])
+@pytest.mark.parametrize("test_onnx", [False, True])
+def test_tome_unmerge(shape, r, test_onnx):
+    from examples.token_merging.export_model import export_unmerge
+
+    inp, ref = export_unmerge(shape, r)
+    run_test(inp, ref, test_onnx=test_onnx)
+
+
+@pytest.mark.parametrize("mode", ['bpe', 'sentencepiece', 'wordpiece'])
+@pytest.mark.parametrize("max_length", [0, 3])
+def test_tokenizer(mode, max_length):
+    from examples.tokenizer.export_model import export
+
+    inp, ref = export(mode, max_length)
+
+    core = Core()
+    core.add_extension(os.getenv('CUSTOM_OP_LIB'))
+    compiled_model = core.compile_model(core.read_model('model.xml'), 'CPU')
+
+    out = compiled_model({'input': inp[0]})
+    for i in range(len(ref)):
+        assert np.array_equal(out[compiled_model.output(i)], ref[i])
@@ -4,8 +4,75 @@
 
 #include "calculate_grid.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#include <openvino/core/parallel.hpp>
+
 using namespace TemplateExtension;
 
+namespace {
+
+// Cells have even coordinates, so a key packs the halves of the coordinates into 21 bits each
+constexpr int key_bits = 21;
+constexpr uint64_t invalid_key = ~uint64_t(0);
+
+uint64_t pack(int x, int y, int z) {
+    OPENVINO_ASSERT(x < (2 << key_bits) && y < (2 << key_bits) && z < (2 << key_bits),
+                    "Grid coordinates exceed ", (2 << key_bits) - 1);
+    return (static_cast<uint64_t>(x >> 1) << (2 * key_bits)) | (static_cast<uint64_t>(y >> 1) << key_bits) |
+           static_cast<uint64_t>(z >> 1);
+}
+
+void unpack(uint64_t key, int* cell) {
+    const uint64_t mask = (uint64_t(1) << key_bits) - 1;
+    cell[0] = static_cast<int>(key >> (2 * key_bits)) * 2;
+    cell[1] = static_cast<int>((key >> key_bits) & mask) * 2;
+    cell[2] = static_cast<int>(key & mask) * 2;
+}
+
+// LSD radix sort by bytes. Every pass is parallel over chunks of the keys: chunks count their digits,
+// the counts are turned into the chunk positions in a fixed order, and every chunk scatters its keys stably.
+void radix_sort(std::vector<uint64_t>& keys) {
+    const size_t size = keys.size();
+    const size_t numChunks = std::max<size_t>(1, std::min<size_t>(ov::parallel_get_max_threads(), size / 4096));
+    const size_t chunk = (size + numChunks - 1) / numChunks;
+
+    // Passes stop at the highest nonzero byte of the keys
+    uint64_t maxKey = 0;
+    for (uint64_t key : keys)
+        maxKey = std::max(maxKey, key);
+
+    std::vector<uint64_t> buffer(size);
+    std::vector<size_t> counts(numChunks * 256);
+    for (int shift = 0; shift < 64 && (maxKey >> shift) != 0; shift += 8) {
+        std::fill(counts.begin(), counts.end(), 0);
+        ov::parallel_for(numChunks, [&](size_t c) {
+            size_t* count = counts.data() + c * 256;
+            for (size_t i = c * chunk; i < std::min(size, (c + 1) * chunk); ++i)
+                count[(keys[i] >> shift) & 0xff] += 1;
+        });
+
+        size_t pos = 0;
+        for (size_t digit = 0; digit < 256; ++digit) {
+            for (size_t c = 0; c < numChunks; ++c) {
+                const size_t count = counts[c * 256 + digit];
+                counts[c * 256 + digit] = pos;
+                pos += count;
+            }
+        }
+
+        ov::parallel_for(numChunks, [&](size_t c) {
+            size_t* next = counts.data() + c * 256;
+            for (size_t i = c * chunk; i < std::min(size, (c + 1) * chunk); ++i)
+                buffer[next[(keys[i] >> shift) & 0xff]++] = keys[i];
+        });
+        keys.swap(buffer);
+    }
+}
+
+}  // namespace
+
 CalculateGrid::CalculateGrid(const ov::Output<ov::Node>& inp_pos) : Op({inp_pos}) {
     constructor_validate_and_infer_types();
 }
@@ -24,39 +91,39 @@ bool CalculateGrid::evaluate(ov::TensorVector& outputs, const ov::TensorVector&
     const float* inpPos = reinterpret_cast<float*>(inputs[0].data());
     float* out = reinterpret_cast<float*>(outputs[0].data());
 
-    std::set<std::tuple<int, int, int> > outPos;
-
     const size_t numPoints = inputs[0].get_shape()[0];
-    static const std::vector<std::vector<int> > filters {{-1, -1, -1}, {-1, -1, 0}, {-1, 0, -1},
-                                                         {-1, 0, 0}, {0, -1, -1}, {0, -1, 0},
-                                                         {0, 0, -1}, {0, 0, 0}};
-
-    std::vector<int> pos(3);
-    for (size_t i = 0; i < numPoints; ++i) {
-        for (size_t j = 0; j < filters.size(); ++j) {
-            bool isValid = true;
-            for (size_t k = 0; k < 3; ++k) {
-                int val = static_cast<int>(inpPos[i * 3 + k]) + filters[j][k];
-                if (val < 0 || val % 2) {
-                    isValid = false;
-                    break;
-                }
-                pos[k] = val;
+
+    // Every point belongs to a single cell: of the offsets {-1, 0} exactly one makes a coordinate even.
+    // The cell is kept if none of its coordinates is negative.
+    std::vector<uint64_t> keys(numPoints);
+    ov::parallel_for(numPoints, [&](size_t i) {
+        int cell[3];
+        for (size_t k = 0; k < 3; ++k) {
+            int val = static_cast<int>(inpPos[i * 3 + k]);
+            if (val < 0) {
+                keys[i] = invalid_key;
+                return;
             }
-            if (isValid)
-                outPos.insert(std::make_tuple(pos[0], pos[1], pos[2]));
+            cell[k] = val - (val & 1);
         }
-    }
+        keys[i] = pack(cell[0], cell[1], cell[2]);
+    });
 
-    int i = 0;
-    for (const auto& it : outPos) {
-        out[i * 3] = 0.5f + std::get<0>(it);
-        out[i * 3 + 1] = 0.5f + std::get<1>(it);
-        out[i * 3 + 2] = 0.5f + std::get<2>(it);
-        i += 1;
-    }
-    memset(out + i * 3, 0, sizeof(float) * 3 * (numPoints - i));
-    out[i * 3] = -1.0f;
+    // Sorted keys follow the lexicographic order of the cell coordinates
+    keys.erase(std::remove(keys.begin(), keys.end(), invalid_key), keys.end());
+    radix_sort(keys);
+    const size_t numCells = std::unique(keys.begin(), keys.end()) - keys.begin();
+
+    ov::parallel_for(numCells, [&](size_t i) {
+        int cell[3];
+        unpack(keys[i], cell);
+        out[i * 3] = 0.5f + cell[0];
+        out[i * 3 + 1] = 0.5f + cell[1];
+        out[i * 3 + 2] = 0.5f + cell[2];
+    });
+    memset(out + numCells * 3, 0, sizeof(float) * 3 * (numPoints - numCells));
+    if (numCells < numPoints)
+        out[numCells * 3] = -1.0f;
     return true;
 }
 
@@ -3,7 +3,15 @@
 //
 
 #include "complex_mul.hpp"
+#include "cpu_isa.hpp"
+
+#include <algorithm>
+#include <cstring>
+
 #include <openvino/core/parallel.hpp>
+#include <openvino/core/type/bfloat16.hpp>
+#include <openvino/core/type/float16.hpp>
+#include <openvino/op/util/attr_types.hpp>
 
 using namespace TemplateExtension;
 
@@ -12,7 +20,15 @@ ComplexMultiplication::ComplexMultiplication(const ov::OutputVector& args) : Op(
 }
 
 void ComplexMultiplication::validate_and_infer_types() {
+    // Inputs are broadcasted against each other NumPy-style, the trailing axis holds complex values
     auto outShape = get_input_partial_shape(0);
+    const auto& shape1 = get_input_partial_shape(1);
+    for (const auto& shape : {outShape, shape1}) {
+        OPENVINO_ASSERT(shape.rank().is_dynamic() || (shape.rank().get_length() > 0 && shape[shape.size() - 1].compatible(2)),
+                        "ComplexMultiplication inputs must have a trailing axis of 2 complex components");
+    }
+    OPENVINO_ASSERT(ov::PartialShape::broadcast_merge_into(outShape, shape1, ov::op::AutoBroadcastType::NUMPY),
+                    "ComplexMultiplication inputs are not broadcastable");
     set_output_type(0, get_input_element_type(1), outShape);
 }
 
@@ -21,53 +37,242 @@ std::shared_ptr<ov::Node> ComplexMultiplication::clone_with_new_inputs(const ov:
     return std::make_shared<ComplexMultiplication>(new_args);
 }
 
-bool ComplexMultiplication::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
-    const float* inp0 = reinterpret_cast<float*>(inputs[0].data());
-    const float* inp1 = reinterpret_cast<float*>(inputs[1].data());
-    float* out = reinterpret_cast<float*>(outputs[0].data());
+namespace {
 
-    size_t channels0 = inputs[0].get_shape()[1];
-    size_t channels1 = inputs[1].get_shape()[1];
-    size_t batch = inputs[0].get_shape()[0];
-    size_t spatialSize = inputs[0].get_shape()[2] * inputs[0].get_shape()[3];
+// Complex numbers processed by a single parallel task
+constexpr size_t block_size = 4096;
 
+// out[i] = a[i * stepA] * b[i], steps are 0 or 1 and count complex numbers. Half precision values are
+// multiplied in float and rounded once on store.
+template <typename T>
+void complex_mul_run(const T* a, size_t stepA, const T* b, T* out, size_t count) {
     // x1 = x_r * y_r - x_i * y_i
     // x2 = x_r * y_i + x_i * y_r
-    if (channels0 == channels1)
-        ov::parallel_for(channels0 * batch, [&](size_t ch) {
-            for (size_t i = 0; i < spatialSize; ++i) {
-                    size_t outIdx = (ch * spatialSize + i) * 2;
-                    float real0 = inp0[outIdx];
-                    float imag0 = inp0[outIdx + 1];
-                    float real1 = inp1[outIdx];
-                    float imag1 = inp1[outIdx + 1];
-                    out[outIdx] = real0 * real1 - imag0 * imag1;
-                    out[outIdx + 1] = real0 * imag1 + imag0 * real1;
-            }
-        });
-    else if (channels1 == 1)
-        ov::parallel_for(channels0 * batch, [&](size_t ch) {
-            size_t b = ch / channels0;
-            for (size_t i = 0; i < spatialSize; ++i) {
-                size_t outIdx = (ch * spatialSize + i) * 2;
-                size_t inpIdx = (b * spatialSize + i) * 2;
-                float real0 = inp0[outIdx];
-                float imag0 = inp0[outIdx + 1];
-                float real1 = inp1[inpIdx];
-                float imag1 = inp1[inpIdx + 1];
-                out[outIdx] = real0 * real1 - imag0 * imag1;
-                out[outIdx + 1] = real0 * imag1 + imag0 * real1;
+    for (size_t i = 0; i < count; ++i) {
+        const float real0 = static_cast<float>(a[2 * i * stepA]);
+        const float imag0 = static_cast<float>(a[2 * i * stepA + 1]);
+        const float real1 = static_cast<float>(b[2 * i]);
+        const float imag1 = static_cast<float>(b[2 * i + 1]);
+        out[2 * i] = T(real0 * real1 - imag0 * imag1);
+        out[2 * i + 1] = T(real0 * imag1 + imag0 * real1);
+    }
+}
+
+CPU_ISA_INLINE void complex_mul_tail(const float* a, size_t stepA, const float* b, float* out, size_t i, size_t count) {
+    for (; i < count; ++i) {
+        const float real0 = a[2 * i * stepA];
+        const float imag0 = a[2 * i * stepA + 1];
+        const float real1 = b[2 * i];
+        const float imag1 = b[2 * i + 1];
+        out[2 * i] = real0 * real1 - imag0 * imag1;
+        out[2 * i + 1] = real0 * imag1 + imag0 * real1;
+    }
+}
+
+// Interleaved complex vectors: real parts of y are duplicated into both lanes of a pair, imaginary parts
+// likewise, and x is multiplied by both with the lanes of its pairs swapped for the second product.
+// fmaddsub (addsub for SSE) subtracts in the even (real) lanes and adds in the odd (imaginary) ones.
+// A broadcasted operand is a single complex number loaded into every lane pair.
+#ifdef CPU_ISA_X86
+CPU_ISA_TARGET_AVX512 void complex_mul_run_avx512(const float* a, size_t stepA, const float* b, float* out, size_t count) {
+    double pair;
+    std::memcpy(&pair, a, sizeof(pair));
+    __m512 x = _mm512_castpd_ps(_mm512_set1_pd(pair));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        if (stepA)
+            x = _mm512_loadu_ps(a + 2 * i);
+        const __m512 y = _mm512_loadu_ps(b + 2 * i);
+        const __m512 swapped = _mm512_permute_ps(x, 0xB1);
+        const __m512 res = _mm512_fmaddsub_ps(x, _mm512_moveldup_ps(y), _mm512_mul_ps(swapped, _mm512_movehdup_ps(y)));
+        _mm512_storeu_ps(out + 2 * i, res);
+    }
+    complex_mul_tail(a, stepA, b, out, i, count);
+}
+
+CPU_ISA_TARGET_AVX2 void complex_mul_run_avx2(const float* a, size_t stepA, const float* b, float* out, size_t count) {
+    double pair;
+    std::memcpy(&pair, a, sizeof(pair));
+    __m256 x = _mm256_castpd_ps(_mm256_set1_pd(pair));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        if (stepA)
+            x = _mm256_loadu_ps(a + 2 * i);
+        const __m256 y = _mm256_loadu_ps(b + 2 * i);
+        const __m256 swapped = _mm256_permute_ps(x, 0xB1);
+        const __m256 res = _mm256_fmaddsub_ps(x, _mm256_moveldup_ps(y), _mm256_mul_ps(swapped, _mm256_movehdup_ps(y)));
+        _mm256_storeu_ps(out + 2 * i, res);
+    }
+    complex_mul_tail(a, stepA, b, out, i, count);
+}
+
+CPU_ISA_TARGET_SSE42 void complex_mul_run_sse42(const float* a, size_t stepA, const float* b, float* out, size_t count) {
+    double pair;
+    std::memcpy(&pair, a, sizeof(pair));
+    __m128 x = _mm_castpd_ps(_mm_set1_pd(pair));
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        if (stepA)
+            x = _mm_loadu_ps(a + 2 * i);
+        const __m128 y = _mm_loadu_ps(b + 2 * i);
+        const __m128 swapped = _mm_shuffle_ps(x, x, 0xB1);
+        const __m128 res = _mm_addsub_ps(_mm_mul_ps(x, _mm_moveldup_ps(y)), _mm_mul_ps(swapped, _mm_movehdup_ps(y)));
+        _mm_storeu_ps(out + 2 * i, res);
+    }
+    complex_mul_tail(a, stepA, b, out, i, count);
+}
+#endif
+
+void complex_mul_run_baseline(const float* a, size_t stepA, const float* b, float* out, size_t count) {
+    complex_mul_tail(a, stepA, b, out, 0, count);
+}
+
+using ComplexMulKernel = void (*)(const float*, size_t, const float*, float*, size_t);
+
+ComplexMulKernel select_complex_mul_kernel() {
+    switch (get_cpu_isa()) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        return complex_mul_run_avx512;
+    case CpuIsa::avx2:
+        return complex_mul_run_avx2;
+    case CpuIsa::sse42:
+        return complex_mul_run_sse42;
+#endif
+    default:
+        return complex_mul_run_baseline;
+    }
+}
+
+// Chosen when the extension is loaded
+const ComplexMulKernel complex_mul_kernel = select_complex_mul_kernel();
+
+template <>
+void complex_mul_run<float>(const float* a, size_t stepA, const float* b, float* out, size_t count) {
+    complex_mul_kernel(a, stepA, b, out, count);
+}
+
+// Output axes merged with their neighbours when both inputs broadcast them the same way. Strides count
+// complex numbers and are 0 along the broadcasted axes of an input.
+struct Layout {
+    std::vector<size_t> dims;
+    std::vector<size_t> strides0;
+    std::vector<size_t> strides1;
+};
+
+Layout make_layout(const ov::Shape& shape0, const ov::Shape& shape1, const ov::Shape& outShape) {
+    // Complex values are the trailing axis of every tensor
+    const size_t rank = outShape.size() - 1;
+    std::vector<size_t> dims;
+    std::vector<bool> full0, full1;
+    for (size_t i = 0; i < rank; ++i) {
+        if (outShape[i] == 1)
+            continue;
+        const size_t d0 = i + shape0.size() >= outShape.size() ? shape0[i + shape0.size() - outShape.size()] : 1;
+        const size_t d1 = i + shape1.size() >= outShape.size() ? shape1[i + shape1.size() - outShape.size()] : 1;
+        if (!dims.empty() && full0.back() == (d0 != 1) && full1.back() == (d1 != 1)) {
+            dims.back() *= outShape[i];
+        } else {
+            dims.push_back(outShape[i]);
+            full0.push_back(d0 != 1);
+            full1.push_back(d1 != 1);
+        }
+    }
+    if (dims.empty()) {
+        dims.push_back(1);
+        full0.push_back(true);
+        full1.push_back(true);
+    }
+
+    Layout layout;
+    layout.dims = dims;
+    layout.strides0.resize(dims.size());
+    layout.strides1.resize(dims.size());
+    size_t size0 = 1, size1 = 1;
+    for (size_t i = dims.size(); i-- > 0;) {
+        layout.strides0[i] = full0[i] ? size0 : 0;
+        layout.strides1[i] = full1[i] ? size1 : 0;
+        size0 *= full0[i] ? dims[i] : 1;
+        size1 *= full1[i] ? dims[i] : 1;
+    }
+    return layout;
+}
+
+template <typename T>
+void complex_multiply(ov::TensorVector& outputs, const ov::TensorVector& inputs) {
+    const T* inp0 = reinterpret_cast<const T*>(inputs[0].data());
+    const T* inp1 = reinterpret_cast<const T*>(inputs[1].data());
+    T* out = reinterpret_cast<T*>(outputs[0].data());
+
+    const Layout layout = make_layout(inputs[0].get_shape(), inputs[1].get_shape(), outputs[0].get_shape());
+    const size_t rank = layout.dims.size();
+    const size_t inner = layout.dims.back();
+    const size_t total = ov::shape_size(outputs[0].get_shape()) / 2;
+
+    // Flattened output is split into blocks, each one walks its part of the index space in runs along the
+    // innermost merged axis. At least one input is contiguous along that axis.
+    ov::parallel_for((total + block_size - 1) / block_size, [&](size_t block) {
+        const size_t begin = block * block_size;
+        const size_t end = std::min(total, begin + block_size);
+
+        // Per thread and only grows, so the blocks do not allocate
+        static thread_local std::vector<size_t> index;
+        index.resize(rank);
+        size_t offset0 = 0, offset1 = 0;
+        for (size_t i = rank, rest = begin; i-- > 0;) {
+            index[i] = rest % layout.dims[i];
+            rest /= layout.dims[i];
+            offset0 += index[i] * layout.strides0[i];
+            offset1 += index[i] * layout.strides1[i];
+        }
+
+        for (size_t pos = begin; pos < end;) {
+            const size_t count = std::min(inner - index.back(), end - pos);
+            // Multiplication is commutative, so the input which steps along the run goes second
+            if (layout.strides1.back())
+                complex_mul_run(inp0 + 2 * offset0, layout.strides0.back(), inp1 + 2 * offset1, out + 2 * pos, count);
+            else
+                complex_mul_run(inp1 + 2 * offset1, size_t(0), inp0 + 2 * offset0, out + 2 * pos, count);
+            pos += count;
+
+            // Next run
+            index.back() += count;
+            offset0 += count * layout.strides0.back();
+            offset1 += count * layout.strides1.back();
+            for (size_t i = rank - 1; i > 0 && index[i] == layout.dims[i]; --i) {
+                index[i] = 0;
+                offset0 -= layout.dims[i] * layout.strides0[i];
+                offset1 -= layout.dims[i] * layout.strides1[i];
+                index[i - 1] += 1;
+                offset0 += layout.strides0[i - 1];
+                offset1 += layout.strides1[i - 1];
             }
-        });
+        }
+    });
+}
+
+}  // namespace
+
+bool ComplexMultiplication::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    const auto type = inputs[0].get_element_type();
+    if (type == ov::element::f32)
+        complex_multiply<float>(outputs, inputs);
+    else if (type == ov::element::f16)
+        complex_multiply<ov::float16>(outputs, inputs);
+    else if (type == ov::element::bf16)
+        complex_multiply<ov::bfloat16>(outputs, inputs);
     else
-        OPENVINO_THROW("Wrong number of channels for second input!");
+        OPENVINO_THROW("Unexpected input type: " + type.to_string());
 
     return true;
 }
 
 bool ComplexMultiplication::has_evaluate() const {
-    for (size_t i = 0; i < get_input_size(); ++i)
-        if (get_input_element_type(i) != ov::element::f32)
+    const auto type = get_input_element_type(0);
+    if (type != ov::element::f32 && type != ov::element::f16 && type != ov::element::bf16)
+        return false;
+    for (size_t i = 1; i < get_input_size(); ++i)
+        if (get_input_element_type(i) != type)
             return false;
     return true;
 }
@@ -0,0 +1,148 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    define CPU_ISA_X86
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#    include <immintrin.h>
+#endif
+
+// The extension is built with the baseline compiler flags. Kernels for wider instruction sets are functions
+// with these attributes, so a single binary carries all of them. MSVC compiles any intrinsic without them.
+#if defined(CPU_ISA_X86) && defined(__GNUC__)
+#    define CPU_ISA_TARGET_SSE42 __attribute__((target("sse4.2")))
+#    define CPU_ISA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#    define CPU_ISA_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#    define CPU_ISA_INLINE inline __attribute__((always_inline))
+#else
+#    define CPU_ISA_TARGET_SSE42
+#    define CPU_ISA_TARGET_AVX2
+#    define CPU_ISA_TARGET_AVX512
+#    if defined(_MSC_VER)
+#        define CPU_ISA_INLINE __forceinline
+#    else
+#        define CPU_ISA_INLINE inline
+#    endif
+#endif
+
+// Code which is too large to annotate function by function, e.g. templates over the vector type, is compiled for
+// an instruction set between these macros. Macros like __AVX2__ keep the values of the compiler flags inside.
+#if defined(CPU_ISA_X86) && defined(__clang__)
+#    define CPU_ISA_BEGIN_TARGET_AVX2 \
+        _Pragma("clang attribute push(__attribute__((target(\"avx2,fma\"))), apply_to = function)")
+#    define CPU_ISA_BEGIN_TARGET_AVX512 \
+        _Pragma("clang attribute push(__attribute__((target(\"avx512f,avx2,fma\"))), apply_to = function)")
+#    define CPU_ISA_END_TARGET _Pragma("clang attribute pop")
+#elif defined(CPU_ISA_X86) && defined(__GNUC__)
+#    define CPU_ISA_BEGIN_TARGET_AVX2 _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+#    define CPU_ISA_BEGIN_TARGET_AVX512 _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma\")")
+#    define CPU_ISA_END_TARGET _Pragma("GCC pop_options")
+#else
+#    define CPU_ISA_BEGIN_TARGET_AVX2
+#    define CPU_ISA_BEGIN_TARGET_AVX512
+#    define CPU_ISA_END_TARGET
+#endif
+
+namespace TemplateExtension {
+
+// Instruction sets the kernels are compiled for, in ascending order. AVX2 includes FMA.
+enum class CpuIsa { baseline, sse42, avx2, avx512 };
+
+namespace cpu_isa_detail {
+
+#ifdef CPU_ISA_X86
+inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#    if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<uint32_t>(r[i]);
+#    else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#    endif
+}
+
+inline uint64_t xgetbv() {
+#    if defined(_MSC_VER)
+    return _xgetbv(0);
+#    else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#    endif
+}
+#endif
+
+inline CpuIsa detect() {
+#ifdef CPU_ISA_X86
+    uint32_t regs[4];
+    cpuid(0, 0, regs);
+    const uint32_t maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const bool sse42 = (regs[2] & (1u << 20)) != 0;
+    const bool fma = (regs[2] & (1u << 12)) != 0;
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+
+    bool avx2 = false, avx512 = false;
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, regs);
+        avx2 = (regs[1] & (1u << 5)) != 0;
+        avx512 = (regs[1] & (1u << 16)) != 0;
+    }
+
+    // The OS has to save the YMM registers, and the opmask and ZMM ones for AVX-512, on context switches
+    const uint64_t xcr0 = osxsave ? xgetbv() : 0;
+    const bool ymm = (xcr0 & 0x6) == 0x6;
+    const bool zmm = (xcr0 & 0xE6) == 0xE6;
+
+    if (avx && avx2 && fma && avx512 && ymm && zmm)
+        return CpuIsa::avx512;
+    if (avx && avx2 && fma && ymm)
+        return CpuIsa::avx2;
+    if (sse42)
+        return CpuIsa::sse42;
+#endif
+    return CpuIsa::baseline;
+}
+
+}  // namespace cpu_isa_detail
+
+// Widest instruction set supported by the host, detected by CPUID once per process. The USER_OV_EXTENSIONS_ISA
+// environment variable (baseline, sse42, avx2 or avx512) lowers it, e.g. to compare the kernels on the same
+// machine. Instruction sets the host does not support and unknown values are ignored.
+inline CpuIsa get_cpu_isa() {
+    static const CpuIsa isa = [] {
+        const CpuIsa detected = cpu_isa_detail::detect();
+        const char* env = std::getenv("USER_OV_EXTENSIONS_ISA");
+        if (!env)
+            return detected;
+
+        const std::string value(env);
+        CpuIsa requested = detected;
+        if (value == "baseline")
+            requested = CpuIsa::baseline;
+        else if (value == "sse42")
+            requested = CpuIsa::sse42;
+        else if (value == "avx2")
+            requested = CpuIsa::avx2;
+        else if (value == "avx512")
+            requested = CpuIsa::avx512;
+        return requested < detected ? requested : detected;
+    }();
+    return isa;
+}
+
+}  // namespace TemplateExtension
@@ -0,0 +1,284 @@
+// Copyright (C) 2018-2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "fft.hpp"
+#include "fft_engine.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include <openvino/core/parallel.hpp>
+#include <openvino/core/type/bfloat16.hpp>
+#include <openvino/core/type/float16.hpp>
+#include <openvino/op/constant.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Batch of 1D signals along a single axis of a tensor. Strides are expressed in tensor elements, which are
+// complex numbers for complex tensors: signal (o, i) starts at o * outer_stride + i * inner_stride and its
+// elements are `stride` apart. Input and output layouts differ for real transforms only.
+struct AxisPass {
+    size_t length;  // transform length
+    size_t stride;
+    size_t outer;
+    size_t inner;
+    size_t in_outer_stride;
+    size_t in_inner_stride;
+    size_t out_outer_stride;
+    size_t out_inner_stride;
+};
+
+// Dimensions are given without the trailing 2 of complex tensors and differ only along the transformed axis
+AxisPass make_pass(const std::vector<size_t>& inDims, const std::vector<size_t>& outDims, size_t axis, size_t length) {
+    AxisPass pass;
+    pass.length = length;
+    pass.stride = std::accumulate(inDims.begin() + axis + 1, inDims.end(), size_t(1), std::multiplies<size_t>());
+    pass.outer = std::accumulate(inDims.begin(), inDims.begin() + axis, size_t(1), std::multiplies<size_t>());
+    pass.in_outer_stride = inDims[axis] * pass.stride;
+    pass.out_outer_stride = outDims[axis] * pass.stride;
+    if (pass.stride != 1) {
+        // Neighbour signals are adjacent in memory
+        pass.inner = pass.stride;
+        pass.in_inner_stride = 1;
+        pass.out_inner_stride = 1;
+    } else {
+        // Innermost axis: batch signals of different rows together
+        pass.inner = pass.outer;
+        pass.in_inner_stride = pass.in_outer_stride;
+        pass.out_inner_stride = pass.out_outer_stride;
+        pass.outer = 1;
+        pass.in_outer_stride = 0;
+        pass.out_outer_stride = 0;
+    }
+    return pass;
+}
+
+AxisPass make_pass(const std::vector<size_t>& dims, size_t axis) {
+    return make_pass(dims, dims, axis, dims[axis]);
+}
+
+template <typename T>
+void run_pass(const T* inp, T* out, const AxisPass& pass, bool inverse, bool centered) {
+    const auto plan = fft_engine::get_plan(pass.length, inverse, centered);
+    const size_t lanes = fft_engine::Plan::lanes();
+    const size_t groups = (pass.inner + lanes - 1) / lanes;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(pass.length));
+
+    ov::parallel_for(pass.outer * groups, [&](size_t d) {
+        const size_t o = d / groups;
+        const size_t i = (d % groups) * lanes;
+        const size_t inpOffset = 2 * (o * pass.in_outer_stride + i * pass.in_inner_stride);
+        const size_t outOffset = 2 * (o * pass.out_outer_stride + i * pass.out_inner_stride);
+        plan->transform(inp + inpOffset, pass.stride, pass.in_inner_stride,
+                        out + outOffset, pass.stride, pass.out_inner_stride,
+                        std::min(lanes, pass.inner - i), scale, fft_engine::get_scratch(plan->scratch_size()));
+    });
+}
+
+// Real-to-complex pass for the forward transform, complex-to-real one for the inverse
+template <typename T>
+void run_real_pass(const T* inp, T* out, const AxisPass& pass, bool inverse) {
+    const auto plan = fft_engine::get_plan(pass.length, inverse, false);
+    const size_t lanes = 2 * fft_engine::Plan::lanes();
+    const size_t groups = (pass.inner + lanes - 1) / lanes;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(pass.length));
+
+    ov::parallel_for(pass.outer * groups, [&](size_t d) {
+        const size_t o = d / groups;
+        const size_t i = (d % groups) * lanes;
+        const size_t inpOffset = o * pass.in_outer_stride + i * pass.in_inner_stride;
+        const size_t outOffset = o * pass.out_outer_stride + i * pass.out_inner_stride;
+        const size_t count = std::min(lanes, pass.inner - i);
+        float* scratch = fft_engine::get_scratch(plan->scratch_size());
+        if (inverse)
+            plan->transform_hermitian(inp + 2 * inpOffset, pass.stride, pass.in_inner_stride,
+                                      out + outOffset, pass.stride, pass.out_inner_stride,
+                                      count, scale, scratch);
+        else
+            plan->transform_real(inp + inpOffset, pass.stride, pass.in_inner_stride,
+                                 out + 2 * outOffset, pass.stride, pass.out_inner_stride,
+                                 count, scale, scratch);
+    });
+}
+
+// Multi-axis transforms of half precision tensors round the result of every pass to the tensor type
+template <typename T>
+void run_transform(const T* inp,
+                   T* out,
+                   const std::vector<size_t>& dims,
+                   const std::vector<size_t>& outDims,
+                   const std::vector<size_t>& axes,
+                   bool inverse,
+                   bool centered,
+                   bool real_input,
+                   bool real_output) {
+    if (real_input) {
+        // Real-to-complex transform of the last signal axis goes first, the others run in-place on its output
+        const size_t last = axes.back();
+        run_real_pass(inp, out, make_pass(dims, outDims, last, dims[last]), inverse);
+        for (size_t i = 0; i + 1 < axes.size(); ++i)
+            run_pass(out, out, make_pass(outDims, axes[i]), inverse, centered);
+    } else if (real_output) {
+        // Complex-to-real transform of the last signal axis goes last
+        const size_t last = axes.back();
+        const T* src = inp;
+        // Grows only, like the plan scratch. It is a buffer of its own, because the calling thread runs the
+        // tasks of the passes as well and they take fft_engine::get_scratch() while the spectrum is in use.
+        static thread_local std::vector<T> spectrum;
+        if (axes.size() > 1 && spectrum.size() < 2 * ov::shape_size(dims))
+            spectrum.resize(2 * ov::shape_size(dims));
+        for (size_t i = 0; i + 1 < axes.size(); ++i) {
+            run_pass(src, spectrum.data(), make_pass(dims, axes[i]), inverse, centered);
+            src = spectrum.data();
+        }
+        run_real_pass(src, out, make_pass(dims, outDims, last, outDims[last]), inverse);
+    } else {
+        // Input is transformed into the output buffer by the first pass, the rest run in-place.
+        // Centered transforms shift every signal axis as a part of its own pass.
+        const T* src = inp;
+        for (size_t axis : axes) {
+            run_pass(src, out, make_pass(dims, axis), inverse, centered);
+            src = out;
+        }
+    }
+}
+
+}  // namespace
+
+FFT::FFT(const ov::OutputVector& args, bool inverse, bool centered) : FFT(args, inverse, centered, false, false) {}
+
+FFT::FFT(const ov::OutputVector& args, bool inverse, bool centered, bool real_input, bool real_output)
+    : Op(args),
+      inverse(inverse),
+      centered(centered),
+      real_input(real_input),
+      real_output(real_output) {
+    constructor_validate_and_infer_types();
+}
+
+void FFT::validate_and_infer_types() {
+    auto outShape = get_input_partial_shape(0);
+    if ((real_input || real_output) && outShape.rank().is_static()) {
+        std::vector<ov::Dimension> dims(outShape.begin(), outShape.end());
+        if (real_output)
+            dims.pop_back();  // complex values
+
+        // Length of the last signal axis changes, so it has to be known at compile time
+        const auto signalDims = ov::as_type_ptr<ov::op::v0::Constant>(input_value(1).get_node_shared_ptr());
+        if (signalDims) {
+            int64_t axis = signalDims->cast_vector<int64_t>().back();
+            axis = axis < 0 ? axis + static_cast<int64_t>(dims.size()) : axis;
+            OPENVINO_ASSERT(0 <= axis && axis < static_cast<int64_t>(dims.size()), "Signal axis is out of range: ", axis);
+            ov::Dimension& length = dims[axis];
+            if (length.is_static())
+                length = real_input ? length.get_length() / 2 + 1 : 2 * (length.get_length() - 1);
+        } else {
+            for (auto& dim : dims)
+                dim = ov::Dimension::dynamic();
+        }
+
+        if (real_input)
+            dims.push_back(2);  // complex values
+        outShape = ov::PartialShape(dims);
+    }
+    set_output_type(0, get_input_element_type(0), outShape);
+}
+
+std::shared_ptr<ov::Node> FFT::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
+    return std::make_shared<FFT>(new_args, inverse, centered);
+}
+
+bool FFT::visit_attributes(ov::AttributeVisitor& visitor) {
+    int inverse_i = static_cast<int>(inverse);
+    int centered_i = static_cast<int>(centered);
+    visitor.on_attribute("inverse", inverse_i);
+    visitor.on_attribute("centered", centered_i);
+    inverse = static_cast<bool>(inverse_i);
+    centered = static_cast<bool>(centered_i);
+    return true;
+}
+
+bool FFT::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    if (inputs[1].get_element_type() != ov::element::i32)
+        OPENVINO_THROW("Unexpected dims type: " + inputs[1].get_element_type().to_string());
+
+    int32_t* signalDimsData = reinterpret_cast<int32_t*>(inputs[1].data());
+    std::vector<size_t> dims = inputs[0].get_shape();
+    const size_t numSignalDims = inputs[1].get_shape()[0];
+
+    std::vector<size_t> outDims = outputs[0].get_shape();
+    if (!real_input)
+        dims.pop_back();  // complex values
+    if (!real_output)
+        outDims.pop_back();
+
+    // Any set of signal axes is transformed as successive 1D passes, each one parallel over the other axes
+    OPENVINO_ASSERT(numSignalDims > 0, "FFT requires at least one signal axis");
+    std::vector<size_t> axes;
+    for (size_t i = 0; i < numSignalDims; ++i) {
+        const int64_t axis = signalDimsData[i] < 0 ? signalDimsData[i] + static_cast<int64_t>(dims.size()) : signalDimsData[i];
+        OPENVINO_ASSERT(0 <= axis && axis < static_cast<int64_t>(dims.size()),
+                        "Signal axis ", signalDimsData[i], " is out of range for ", dims.size(), "D signal");
+        OPENVINO_ASSERT(std::find(axes.begin(), axes.end(), static_cast<size_t>(axis)) == axes.end(),
+                        "Signal axis ", signalDimsData[i], " is repeated");
+        axes.push_back(static_cast<size_t>(axis));
+    }
+
+    const auto type = inputs[0].get_element_type();
+    if (type == ov::element::f32)
+        run_transform(reinterpret_cast<const float*>(inputs[0].data()), reinterpret_cast<float*>(outputs[0].data()),
+                      dims, outDims, axes, inverse, centered, real_input, real_output);
+    else if (type == ov::element::f16)
+        run_transform(reinterpret_cast<const ov::float16*>(inputs[0].data()),
+                      reinterpret_cast<ov::float16*>(outputs[0].data()),
+                      dims, outDims, axes, inverse, centered, real_input, real_output);
+    else if (type == ov::element::bf16)
+        run_transform(reinterpret_cast<const ov::bfloat16*>(inputs[0].data()),
+                      reinterpret_cast<ov::bfloat16*>(outputs[0].data()),
+                      dims, outDims, axes, inverse, centered, real_input, real_output);
+    else
+        OPENVINO_THROW("Unexpected input type: " + type.to_string());
+    return true;
+}
+
+bool FFT::has_evaluate() const {
+    const auto type = get_input_element_type(0);
+    if (type != ov::element::f32 && type != ov::element::f16 && type != ov::element::bf16)
+        return false;
+    return get_input_element_type(1) == ov::element::i32;
+}
+
+RFFT::RFFT() {
+    real_input = true;
+}
+
+RFFT::RFFT(const ov::OutputVector& args) : FFT(args, false, false, true, false) {}
+
+std::shared_ptr<ov::Node> RFFT::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
+    return std::make_shared<RFFT>(new_args);
+}
+
+bool RFFT::visit_attributes(ov::AttributeVisitor&) {
+    return true;
+}
+
+IRFFT::IRFFT() {
+    inverse = true;
+    real_output = true;
+}
+
+IRFFT::IRFFT(const ov::OutputVector& args) : FFT(args, true, false, false, true) {}
+
+std::shared_ptr<ov::Node> IRFFT::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
+    return std::make_shared<IRFFT>(new_args);
+}
+
+bool IRFFT::visit_attributes(ov::AttributeVisitor&) {
+    return true;
+}
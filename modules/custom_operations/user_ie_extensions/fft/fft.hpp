@@ -0,0 +1,68 @@
+// Copyright (C) 2018-2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+class FFT : public ov::op::Op {
+public:
+    OPENVINO_OP("FFT");
+
+    FFT() = default;
+    FFT(const ov::OutputVector& args, bool inverse, bool centered);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+    bool get_inverse() const {
+        return inverse;
+    }
+    bool get_centered() const {
+        return centered;
+    }
+    bool is_real() const {
+        return real_input || real_output;
+    }
+
+protected:
+    FFT(const ov::OutputVector& args, bool inverse, bool centered, bool real_input, bool real_output);
+
+    bool inverse = false;
+    bool centered = false;
+    // Input is a real signal. Output keeps N / 2 + 1 non-redundant bins along the last signal axis.
+    bool real_input = false;
+    // Input is a Hermitian half-spectrum of M bins along the last signal axis. Output is a real signal
+    // of 2 * (M - 1) elements along this axis.
+    bool real_output = false;
+};
+
+// FFT of a real signal, matches torch.fft.rfftn(x, dims, norm="ortho")
+class RFFT : public FFT {
+public:
+    OPENVINO_OP("RFFT");
+
+    RFFT();
+    RFFT(const ov::OutputVector& args);
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+};
+
+// Inverse of RFFT, matches torch.fft.irfftn(x, dims, norm="ortho")
+class IRFFT : public FFT {
+public:
+    OPENVINO_OP("IRFFT");
+
+    IRFFT();
+    IRFFT(const ov::OutputVector& args);
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+};
+
+}  // namespace TemplateExtension
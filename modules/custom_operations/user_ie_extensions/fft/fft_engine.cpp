@@ -0,0 +1,326 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "fft_engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <openvino/core/except.hpp>
+#include <openvino/core/type/bfloat16.hpp>
+#include <openvino/core/type/float16.hpp>
+
+#include "../cpu_isa.hpp"
+
+// The butterflies and the loads and stores around them are compiled for every instruction set the extension can
+// run with, the transforms go to the widest one of the host
+#ifdef CPU_ISA_X86
+CPU_ISA_BEGIN_TARGET_AVX512
+#    define FFT_KERNELS_NAMESPACE avx512
+#    define FFT_KERNELS_AVX512
+#    include "fft_kernels.hpp"
+#    undef FFT_KERNELS_AVX512
+#    undef FFT_KERNELS_NAMESPACE
+CPU_ISA_END_TARGET
+
+CPU_ISA_BEGIN_TARGET_AVX2
+#    define FFT_KERNELS_NAMESPACE avx2
+#    define FFT_KERNELS_AVX2
+#    include "fft_kernels.hpp"
+#    undef FFT_KERNELS_AVX2
+#    undef FFT_KERNELS_NAMESPACE
+CPU_ISA_END_TARGET
+#endif
+
+#define FFT_KERNELS_NAMESPACE baseline
+#include "fft_kernels.hpp"
+#undef FFT_KERNELS_NAMESPACE
+
+using namespace TemplateExtension;
+using namespace TemplateExtension::fft_engine;
+
+namespace {
+
+// SSE4.2 adds nothing to the baseline kernels
+CpuIsa select_fft_kernels() {
+    const CpuIsa isa = get_cpu_isa();
+#ifdef CPU_ISA_X86
+    if (isa == CpuIsa::avx512 || isa == CpuIsa::avx2)
+        return isa;
+#endif
+    return CpuIsa::baseline;
+}
+
+// Chosen when the extension is loaded
+const CpuIsa fft_kernels_isa = select_fft_kernels();
+
+// Reference transform in double precision, used to prepare the Bluestein kernel
+void transform_pow2(std::vector<std::complex<double>>& data) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+    const double pi = std::acos(-1.0);
+    for (size_t len = 2; len <= n; len <<= 1) {
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < len / 2; ++j) {
+                const std::complex<double> w = std::polar(1.0, -2.0 * pi * j / len);
+                const std::complex<double> u = data[i + j];
+                const std::complex<double> v = data[i + j + len / 2] * w;
+                data[i + j] = u + v;
+                data[i + j + len / 2] = u - v;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+Plan::Plan(size_t length, bool inverse, bool centered) : n(length), inverse(inverse), shift(centered ? length / 2 : 0) {
+    OPENVINO_ASSERT(n > 0, "FFT length must be positive");
+    OPENVINO_ASSERT(n <= std::numeric_limits<uint32_t>::max() / 2, "FFT length is too large: ", n);
+
+    std::vector<size_t> radices;
+    size_t rest = n;
+    for (size_t radix : {4, 2, 3, 5}) {
+        while (rest % radix == 0) {
+            radices.push_back(radix);
+            rest /= radix;
+        }
+    }
+
+    const double pi = std::acos(-1.0);
+    const double sign = inverse ? 1.0 : -1.0;
+
+    if (rest != 1) {
+        // Bluestein's algorithm: X[k] = c[k] * sum_j (x[j] * c[j]) * conj(c[k - j]), c[j] = exp(sign * pi * i * j^2 / n)
+        size_t m = 1;
+        while (m < 2 * n - 1)
+            m <<= 1;
+        conv.reset(new Plan(m, false));
+
+        chirp.resize(2 * n);
+        std::vector<std::complex<double>> spectrum(m);
+        for (size_t j = 0; j < n; ++j) {
+            // j^2 mod 2n keeps the angle accurate for long signals
+            const double angle = sign * pi * static_cast<double>((j * j) % (2 * n)) / n;
+            chirp[2 * j] = static_cast<float>(std::cos(angle));
+            chirp[2 * j + 1] = static_cast<float>(std::sin(angle));
+            spectrum[j] = std::polar(1.0 / m, -angle);
+            if (j != 0)
+                spectrum[m - j] = spectrum[j];
+        }
+        transform_pow2(spectrum);
+
+        kernel.resize(2 * m);
+        for (size_t k = 0; k < m; ++k) {
+            kernel[2 * k] = static_cast<float>(spectrum[k].real());
+            kernel[2 * k + 1] = static_cast<float>(spectrum[k].imag());
+        }
+        return;
+    }
+
+    size_t span = 1;
+    for (size_t radix : radices) {
+        stages.push_back({radix, span, twiddles.size()});
+        for (size_t j = 0; j < span; ++j) {
+            for (size_t q = 1; q < radix; ++q) {
+                const double angle = sign * 2.0 * pi * static_cast<double>(j * q) / static_cast<double>(radix * span);
+                twiddles.push_back(static_cast<float>(std::cos(angle)));
+                twiddles.push_back(static_cast<float>(std::sin(angle)));
+            }
+        }
+        span *= radix;
+    }
+
+    // Decimation in time consumes the input in digit-reversed order
+    perm.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t rem = i;
+        size_t size = n;
+        size_t pos = 0;
+        for (size_t s = radices.size(); s-- > 0;) {
+            size /= radices[s];
+            pos += (rem % radices[s]) * size;
+            rem /= radices[s];
+        }
+        perm[pos] = static_cast<uint32_t>((i + shift) % n);
+    }
+}
+
+Plan::~Plan() = default;
+
+size_t Plan::lanes() {
+    switch (fft_kernels_isa) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        return avx512::Kernels::lanes();
+    case CpuIsa::avx2:
+        return avx2::Kernels::lanes();
+#endif
+    default:
+        return baseline::Kernels::lanes();
+    }
+}
+
+size_t Plan::scratch_size() const {
+    // Work buffers followed by a tile for the strided signals (or the spectrum of a real transform), a block of
+    // the work buffers keeps the real and imaginary parts of an element of all the signals
+    const size_t block_size = 2 * lanes();
+    return conv ? (2 * conv->length() + n) * block_size : 2 * n * block_size;
+}
+
+template <typename T>
+void Plan::transform(const T* in,
+                     ptrdiff_t in_stride,
+                     ptrdiff_t in_dist,
+                     T* out,
+                     ptrdiff_t out_stride,
+                     ptrdiff_t out_dist,
+                     size_t count,
+                     float scale,
+                     float* scratch) const {
+    OPENVINO_ASSERT(count <= lanes(), "FFT plan transforms at most ", lanes(), " signals at once");
+    switch (fft_kernels_isa) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        avx512::Kernels::transform(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+    case CpuIsa::avx2:
+        avx2::Kernels::transform(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+#endif
+    default:
+        baseline::Kernels::transform(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+    }
+}
+
+template <typename T>
+void Plan::transform_real(const T* in,
+                          ptrdiff_t in_stride,
+                          ptrdiff_t in_dist,
+                          T* out,
+                          ptrdiff_t out_stride,
+                          ptrdiff_t out_dist,
+                          size_t count,
+                          float scale,
+                          float* scratch) const {
+    OPENVINO_ASSERT(count <= 2 * lanes(), "FFT plan transforms at most ", 2 * lanes(), " real signals at once");
+    switch (fft_kernels_isa) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        avx512::Kernels::transform_real(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+    case CpuIsa::avx2:
+        avx2::Kernels::transform_real(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+#endif
+    default:
+        baseline::Kernels::transform_real(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+    }
+}
+
+template <typename T>
+void Plan::transform_hermitian(const T* in,
+                               ptrdiff_t in_stride,
+                               ptrdiff_t in_dist,
+                               T* out,
+                               ptrdiff_t out_stride,
+                               ptrdiff_t out_dist,
+                               size_t count,
+                               float scale,
+                               float* scratch) const {
+    OPENVINO_ASSERT(count <= 2 * lanes(), "FFT plan transforms at most ", 2 * lanes(), " real signals at once");
+    switch (fft_kernels_isa) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        avx512::Kernels::transform_hermitian(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+    case CpuIsa::avx2:
+        avx2::Kernels::transform_hermitian(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+#endif
+    default:
+        baseline::Kernels::transform_hermitian(*this, in, in_stride, in_dist, out, out_stride, out_dist, count, scale, scratch);
+        break;
+    }
+}
+
+#define TRANSFORM_ARGS(T) const T*, ptrdiff_t, ptrdiff_t, T*, ptrdiff_t, ptrdiff_t, size_t, float, float*
+#define INSTANTIATE_TRANSFORMS(T)                                             \
+    template void Plan::transform<T>(TRANSFORM_ARGS(T)) const;                \
+    template void Plan::transform_real<T>(TRANSFORM_ARGS(T)) const;           \
+    template void Plan::transform_hermitian<T>(TRANSFORM_ARGS(T)) const;
+
+INSTANTIATE_TRANSFORMS(float)
+INSTANTIATE_TRANSFORMS(ov::float16)
+INSTANTIATE_TRANSFORMS(ov::bfloat16)
+
+#undef INSTANTIATE_TRANSFORMS
+#undef TRANSFORM_ARGS
+
+std::shared_ptr<const Plan> TemplateExtension::fft_engine::get_plan(size_t length, bool inverse, bool centered) {
+    // Plans are small compared to the tensors, but keep the cache bounded for models with many shapes. The least
+    // recently used plan is evicted when it is full, plans in use stay alive through their owners.
+    static const size_t capacity = 64;
+    using Key = std::tuple<size_t, bool, bool>;
+    struct Entry {
+        std::shared_ptr<const Plan> plan;
+        std::list<Key>::iterator use;
+    };
+    static std::mutex mutex;
+    static std::list<Key> uses;  // most recently used first
+    static std::map<Key, Entry> plans;
+
+    const Key key = std::make_tuple(length, inverse, centered);
+    // Returns the cached plan and marks it as the most recently used one, the mutex has to be locked
+    auto find = [&]() -> std::shared_ptr<const Plan> {
+        auto it = plans.find(key);
+        if (it == plans.end())
+            return nullptr;
+        uses.splice(uses.begin(), uses, it->second.use);
+        return it->second.plan;
+    };
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto plan = find())
+            return plan;
+    }
+
+    // Built without the lock: twiddles and Bluestein kernels of long signals take a while, other threads keep
+    // looking up the cache meanwhile
+    std::shared_ptr<const Plan> plan = std::make_shared<Plan>(length, inverse, centered);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another thread may have built the same plan meanwhile, all the callers share the cached one
+    if (auto cached = find())
+        return cached;
+    if (plans.size() >= capacity) {
+        plans.erase(uses.back());
+        uses.pop_back();
+    }
+    uses.push_front(key);
+    plans.emplace(key, Entry{plan, uses.begin()});
+    return plan;
+}
+
+float* TemplateExtension::fft_engine::get_scratch(size_t size) {
+    static thread_local std::vector<float> scratch;
+    if (scratch.size() < size)
+        scratch.resize(size);
+    return scratch.data();
+}
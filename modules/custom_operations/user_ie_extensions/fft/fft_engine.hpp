@@ -0,0 +1,131 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TemplateExtension {
+namespace fft_engine {
+
+// Transforms compiled for a specific instruction set, see fft_kernels.hpp
+namespace avx512 {
+struct Kernels;
+}
+namespace avx2 {
+struct Kernels;
+}
+namespace baseline {
+struct Kernels;
+}
+
+// Mixed-radix (4, 2, 3, 5) decimation-in-time FFT of a fixed length. Lengths with prime factors
+// greater than 5 are computed with Bluestein's algorithm on top of a power-of-two transform.
+//
+// A plan transforms several signals at once: every SIMD lane holds an element of a different signal,
+// so butterflies are vectorized across the batch and the twiddles are shared by all the lanes.
+//
+// A centered plan computes fftshift(FFT(ifftshift(x))). Both shifts are folded into the indices the
+// input is gathered from and the output is stored to, so they cost no extra passes over the data.
+//
+// The transforms are instantiated for float, ov::float16 and ov::bfloat16 tensors. Half precision
+// elements are converted when they are loaded and stored; butterflies and twiddles are always float.
+class Plan {
+public:
+    Plan(size_t length, bool inverse, bool centered = false);
+    ~Plan();
+
+    size_t length() const {
+        return n;
+    }
+
+    // Number of signals processed by a single transform() call. It is the SIMD width of the widest
+    // instruction set of the host the kernels are compiled for.
+    static size_t lanes();
+
+    // Number of floats of scratch memory required by transform().
+    size_t scratch_size() const;
+
+    // Transforms `count` (up to lanes()) interleaved complex signals. The k-th element of the signal l
+    // is read from in[2 * (l * in_dist + k * in_stride)] and the result multiplied by `scale` is written
+    // to out[2 * (l * out_dist + k * out_stride)]. Input and output may refer to the same memory.
+    template <typename T>
+    void transform(const T* in,
+                   ptrdiff_t in_stride,
+                   ptrdiff_t in_dist,
+                   T* out,
+                   ptrdiff_t out_stride,
+                   ptrdiff_t out_dist,
+                   size_t count,
+                   float scale,
+                   float* scratch) const;
+
+    // Transforms `count` (up to 2 * lanes()) real signals of a forward plan and stores the length() / 2 + 1
+    // non-redundant bins of their spectra. Pairs of real signals are packed into a single complex one.
+    // The k-th element of the signal l is read from in[l * in_dist + k * in_stride], the k-th bin of its
+    // spectrum is written to out[2 * (l * out_dist + k * out_stride)].
+    template <typename T>
+    void transform_real(const T* in,
+                        ptrdiff_t in_stride,
+                        ptrdiff_t in_dist,
+                        T* out,
+                        ptrdiff_t out_stride,
+                        ptrdiff_t out_dist,
+                        size_t count,
+                        float scale,
+                        float* scratch) const;
+
+    // Inverse of transform_real() for an inverse plan: reads length() / 2 + 1 bins of Hermitian spectra
+    // from in[2 * (l * in_dist + k * in_stride)] and writes real signals to out[l * out_dist + k * out_stride].
+    template <typename T>
+    void transform_hermitian(const T* in,
+                             ptrdiff_t in_stride,
+                             ptrdiff_t in_dist,
+                             T* out,
+                             ptrdiff_t out_stride,
+                             ptrdiff_t out_dist,
+                             size_t count,
+                             float scale,
+                             float* scratch) const;
+
+private:
+    friend struct avx512::Kernels;
+    friend struct avx2::Kernels;
+    friend struct baseline::Kernels;
+
+    struct Stage {
+        size_t radix;
+        size_t span;      // length of the sub-transforms combined by the stage
+        size_t twiddles;  // offset of the stage twiddles in `twiddles`
+    };
+
+    size_t n;
+    bool inverse;
+    size_t shift;  // n / 2 for centered plans, 0 otherwise
+
+    // Direct mixed-radix transform
+    std::vector<Stage> stages;
+    std::vector<float> twiddles;
+    std::vector<uint32_t> perm;  // input element gathered into each position of the work buffer, shift included
+
+    // Bluestein's algorithm: convolution with a chirp by means of a power-of-two transform
+    std::unique_ptr<Plan> conv;
+    std::vector<float> chirp;
+    std::vector<float> kernel;
+};
+
+// Returns a plan shared by all the FFT nodes. Plans are built on the first request for a given
+// configuration, so repeated inferences of the same shape do no setup work. A plan serves tensors of
+// every element type.
+std::shared_ptr<const Plan> get_plan(size_t length, bool inverse, bool centered);
+
+// Returns scratch memory of at least `size` floats owned by the calling thread. The buffer only grows,
+// so it is allocated once per thread for a fixed set of shapes.
+float* get_scratch(size_t size);
+
+}  // namespace fft_engine
+}  // namespace TemplateExtension
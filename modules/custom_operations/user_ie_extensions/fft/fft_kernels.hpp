@@ -0,0 +1,715 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// The parts of the FFT engine which depend on the SIMD width. fft_engine.cpp includes this file once per
+// instruction set, inside a region compiled for it, so there is no include guard. The includer defines
+// FFT_KERNELS_NAMESPACE and FFT_KERNELS_AVX512 or FFT_KERNELS_AVX2; without the latter the kernels use SSE2
+// if the baseline has it and portable code otherwise.
+
+namespace TemplateExtension {
+namespace fft_engine {
+namespace FFT_KERNELS_NAMESPACE {
+namespace {
+
+//
+// SIMD primitives. A vector keeps one float of every signal in the batch.
+//
+
+#if defined(FFT_KERNELS_AVX512)
+
+using vec_t = __m512;
+constexpr size_t vec_width = 16;
+
+inline vec_t vload(const float* p) { return _mm512_loadu_ps(p); }
+inline void vstore(float* p, vec_t a) { _mm512_storeu_ps(p, a); }
+inline vec_t vset1(float a) { return _mm512_set1_ps(a); }
+inline vec_t vadd(vec_t a, vec_t b) { return _mm512_add_ps(a, b); }
+inline vec_t vsub(vec_t a, vec_t b) { return _mm512_sub_ps(a, b); }
+inline vec_t vmul(vec_t a, vec_t b) { return _mm512_mul_ps(a, b); }
+inline vec_t vneg(vec_t a) { return _mm512_sub_ps(_mm512_setzero_ps(), a); }
+// a * b + c
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) { return _mm512_fmadd_ps(a, b, c); }
+// c - a * b
+inline vec_t vfnmadd(vec_t a, vec_t b, vec_t c) { return _mm512_fnmadd_ps(a, b, c); }
+
+// Loads vec_width adjacent interleaved complex numbers
+inline void vload_complex(const float* p, vec_t& re, vec_t& im) {
+    const __m512i even = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i odd = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+    const vec_t a = _mm512_loadu_ps(p);
+    const vec_t b = _mm512_loadu_ps(p + 16);
+    re = _mm512_permutex2var_ps(a, even, b);
+    im = _mm512_permutex2var_ps(a, odd, b);
+}
+
+// Stores vec_width adjacent interleaved complex numbers
+inline void vstore_complex(float* p, vec_t re, vec_t im) {
+    const __m512i lo = _mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+    const __m512i hi = _mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8);
+    _mm512_storeu_ps(p, _mm512_permutex2var_ps(re, lo, im));
+    _mm512_storeu_ps(p + 16, _mm512_permutex2var_ps(re, hi, im));
+}
+
+#elif defined(FFT_KERNELS_AVX2)
+
+using vec_t = __m256;
+constexpr size_t vec_width = 8;
+
+inline vec_t vload(const float* p) { return _mm256_loadu_ps(p); }
+inline void vstore(float* p, vec_t a) { _mm256_storeu_ps(p, a); }
+inline vec_t vset1(float a) { return _mm256_set1_ps(a); }
+inline vec_t vadd(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+inline vec_t vsub(vec_t a, vec_t b) { return _mm256_sub_ps(a, b); }
+inline vec_t vmul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+inline vec_t vneg(vec_t a) { return _mm256_sub_ps(_mm256_setzero_ps(), a); }
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) { return _mm256_fmadd_ps(a, b, c); }
+inline vec_t vfnmadd(vec_t a, vec_t b, vec_t c) { return _mm256_fnmadd_ps(a, b, c); }
+
+inline void vload_complex(const float* p, vec_t& re, vec_t& im) {
+    const vec_t a = _mm256_loadu_ps(p);
+    const vec_t b = _mm256_loadu_ps(p + 8);
+    // Shuffles work within 128-bit halves, so restore the order of 64-bit pairs afterwards
+    const __m256d even = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    const __m256d odd = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    re = _mm256_castpd_ps(_mm256_permute4x64_pd(even, _MM_SHUFFLE(3, 1, 2, 0)));
+    im = _mm256_castpd_ps(_mm256_permute4x64_pd(odd, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+inline void vstore_complex(float* p, vec_t re, vec_t im) {
+    re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3, 1, 2, 0)));
+    im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm256_storeu_ps(p, _mm256_unpacklo_ps(re, im));
+    _mm256_storeu_ps(p + 8, _mm256_unpackhi_ps(re, im));
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+using vec_t = __m128;
+constexpr size_t vec_width = 4;
+
+inline vec_t vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, vec_t a) { _mm_storeu_ps(p, a); }
+inline vec_t vset1(float a) { return _mm_set1_ps(a); }
+inline vec_t vadd(vec_t a, vec_t b) { return _mm_add_ps(a, b); }
+inline vec_t vsub(vec_t a, vec_t b) { return _mm_sub_ps(a, b); }
+inline vec_t vmul(vec_t a, vec_t b) { return _mm_mul_ps(a, b); }
+inline vec_t vneg(vec_t a) { return _mm_sub_ps(_mm_setzero_ps(), a); }
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline vec_t vfnmadd(vec_t a, vec_t b, vec_t c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+
+inline void vload_complex(const float* p, vec_t& re, vec_t& im) {
+    const vec_t a = _mm_loadu_ps(p);
+    const vec_t b = _mm_loadu_ps(p + 4);
+    re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline void vstore_complex(float* p, vec_t re, vec_t im) {
+    _mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+}
+
+#else
+
+// Portable fallback, vectorized by the compiler where possible
+constexpr size_t vec_width = 4;
+struct vec_t {
+    float v[vec_width];
+};
+
+inline vec_t vload(const float* p) {
+    vec_t r;
+    for (size_t i = 0; i < vec_width; ++i)
+        r.v[i] = p[i];
+    return r;
+}
+inline void vstore(float* p, vec_t a) {
+    for (size_t i = 0; i < vec_width; ++i)
+        p[i] = a.v[i];
+}
+inline vec_t vset1(float a) {
+    vec_t r;
+    for (size_t i = 0; i < vec_width; ++i)
+        r.v[i] = a;
+    return r;
+}
+inline vec_t vadd(vec_t a, vec_t b) {
+    for (size_t i = 0; i < vec_width; ++i)
+        a.v[i] += b.v[i];
+    return a;
+}
+inline vec_t vsub(vec_t a, vec_t b) {
+    for (size_t i = 0; i < vec_width; ++i)
+        a.v[i] -= b.v[i];
+    return a;
+}
+inline vec_t vmul(vec_t a, vec_t b) {
+    for (size_t i = 0; i < vec_width; ++i)
+        a.v[i] *= b.v[i];
+    return a;
+}
+inline vec_t vneg(vec_t a) {
+    for (size_t i = 0; i < vec_width; ++i)
+        a.v[i] = -a.v[i];
+    return a;
+}
+inline vec_t vfmadd(vec_t a, vec_t b, vec_t c) { return vadd(vmul(a, b), c); }
+inline vec_t vfnmadd(vec_t a, vec_t b, vec_t c) { return vsub(c, vmul(a, b)); }
+
+inline void vload_complex(const float* p, vec_t& re, vec_t& im) {
+    for (size_t i = 0; i < vec_width; ++i) {
+        re.v[i] = p[2 * i];
+        im.v[i] = p[2 * i + 1];
+    }
+}
+
+inline void vstore_complex(float* p, vec_t re, vec_t im) {
+    for (size_t i = 0; i < vec_width; ++i) {
+        p[2 * i] = re.v[i];
+        p[2 * i + 1] = im.v[i];
+    }
+}
+
+#endif
+
+// Work buffers keep a block of vec_width real parts followed by vec_width imaginary parts per element
+constexpr size_t block_size = 2 * vec_width;
+
+struct cvec {
+    vec_t re;
+    vec_t im;
+};
+
+inline cvec cadd(const cvec& a, const cvec& b) { return {vadd(a.re, b.re), vadd(a.im, b.im)}; }
+inline cvec csub(const cvec& a, const cvec& b) { return {vsub(a.re, b.re), vsub(a.im, b.im)}; }
+inline cvec cscale(const cvec& a, vec_t s) { return {vmul(a.re, s), vmul(a.im, s)}; }
+inline cvec cconj(const cvec& a) { return {a.re, vneg(a.im)}; }
+// a * (wr + i * wi)
+inline cvec cmul(const cvec& a, vec_t wr, vec_t wi) {
+    return {vfnmadd(a.im, wi, vmul(a.re, wr)), vfmadd(a.re, wi, vmul(a.im, wr))};
+}
+// a * i * s
+inline cvec cmul_i(const cvec& a, vec_t s) { return {vmul(vneg(a.im), s), vmul(a.re, s)}; }
+
+inline cvec load_block(const float* work, size_t k) {
+    return {vload(work + k * block_size), vload(work + k * block_size + vec_width)};
+}
+
+inline void store_block(float* work, size_t k, const cvec& y) {
+    vstore(work + k * block_size, y.re);
+    vstore(work + k * block_size + vec_width, y.im);
+}
+
+//
+// Tensor element access. Half precision elements are widened on load and narrowed on store, all the
+// arithmetic is done in single precision.
+//
+
+template <typename T>
+inline void load_values(const T* p, vec_t& a) {
+    float buf[vec_width];
+    for (size_t i = 0; i < vec_width; ++i)
+        buf[i] = static_cast<float>(p[i]);
+    a = vload(buf);
+}
+
+inline void load_values(const float* p, vec_t& a) {
+    a = vload(p);
+}
+
+template <typename T>
+inline void store_values(T* p, vec_t a) {
+    float buf[vec_width];
+    vstore(buf, a);
+    for (size_t i = 0; i < vec_width; ++i)
+        p[i] = T(buf[i]);
+}
+
+inline void store_values(float* p, vec_t a) {
+    vstore(p, a);
+}
+
+template <typename T>
+inline void load_complex(const T* p, vec_t& re, vec_t& im) {
+    float buf[block_size];
+    for (size_t i = 0; i < block_size; ++i)
+        buf[i] = static_cast<float>(p[i]);
+    vload_complex(buf, re, im);
+}
+
+inline void load_complex(const float* p, vec_t& re, vec_t& im) {
+    vload_complex(p, re, im);
+}
+
+template <typename T>
+inline void store_complex(T* p, vec_t re, vec_t im) {
+    float buf[block_size];
+    vstore_complex(buf, re, im);
+    for (size_t i = 0; i < block_size; ++i)
+        p[i] = T(buf[i]);
+}
+
+inline void store_complex(float* p, vec_t re, vec_t im) {
+    vstore_complex(p, re, im);
+}
+
+//
+// Butterflies. `inverse` selects the sign of the exponent: exp(+2 pi i / R) for the inverse transform.
+//
+
+inline void butterfly2(cvec* y, bool) {
+    const cvec t = y[1];
+    y[1] = csub(y[0], t);
+    y[0] = cadd(y[0], t);
+}
+
+inline void butterfly3(cvec* y, bool inverse) {
+    const float sin60 = 0.866025403784438647f;
+    const cvec t = cadd(y[1], y[2]);
+    const cvec u = cmul_i(csub(y[1], y[2]), vset1(inverse ? sin60 : -sin60));
+    const cvec base = {vfnmadd(t.re, vset1(0.5f), y[0].re), vfnmadd(t.im, vset1(0.5f), y[0].im)};
+    y[0] = cadd(y[0], t);
+    y[1] = cadd(base, u);
+    y[2] = csub(base, u);
+}
+
+inline void butterfly4(cvec* y, bool inverse) {
+    const cvec t0 = cadd(y[0], y[2]);
+    const cvec t1 = csub(y[0], y[2]);
+    const cvec t2 = cadd(y[1], y[3]);
+    const cvec t3 = cmul_i(csub(y[1], y[3]), vset1(inverse ? 1.0f : -1.0f));
+    y[0] = cadd(t0, t2);
+    y[1] = cadd(t1, t3);
+    y[2] = csub(t0, t2);
+    y[3] = csub(t1, t3);
+}
+
+inline void butterfly5(cvec* y, bool inverse) {
+    const vec_t c1 = vset1(0.309016994374947424f);   // cos(2 pi / 5)
+    const vec_t c2 = vset1(-0.809016994374947424f);  // cos(4 pi / 5)
+    const vec_t s1 = vset1(inverse ? 0.951056516295153572f : -0.951056516295153572f);
+    const vec_t s2 = vset1(inverse ? 0.587785252292473129f : -0.587785252292473129f);
+
+    const cvec t1 = cadd(y[1], y[4]);
+    const cvec t2 = cadd(y[2], y[3]);
+    const cvec u1 = csub(y[1], y[4]);
+    const cvec u2 = csub(y[2], y[3]);
+
+    const cvec a1 = {vfmadd(c2, t2.re, vfmadd(c1, t1.re, y[0].re)), vfmadd(c2, t2.im, vfmadd(c1, t1.im, y[0].im))};
+    const cvec a2 = {vfmadd(c1, t2.re, vfmadd(c2, t1.re, y[0].re)), vfmadd(c1, t2.im, vfmadd(c2, t1.im, y[0].im))};
+    // i * (s1 * u1 + s2 * u2) and i * (s2 * u1 - s1 * u2)
+    const cvec b1 = {vneg(vfmadd(s2, u2.im, vmul(s1, u1.im))), vfmadd(s2, u2.re, vmul(s1, u1.re))};
+    const cvec b2 = {vfmadd(s1, u2.im, vneg(vmul(s2, u1.im))), vfnmadd(s1, u2.re, vmul(s2, u1.re))};
+
+    y[0] = cadd(y[0], cadd(t1, t2));
+    y[1] = cadd(a1, b1);
+    y[4] = csub(a1, b1);
+    y[2] = cadd(a2, b2);
+    y[3] = csub(a2, b2);
+}
+
+template <size_t R>
+inline void butterfly(cvec* y, bool inverse);
+template <>
+inline void butterfly<2>(cvec* y, bool inverse) { butterfly2(y, inverse); }
+template <>
+inline void butterfly<3>(cvec* y, bool inverse) { butterfly3(y, inverse); }
+template <>
+inline void butterfly<4>(cvec* y, bool inverse) { butterfly4(y, inverse); }
+template <>
+inline void butterfly<5>(cvec* y, bool inverse) { butterfly5(y, inverse); }
+
+// Combines R sub-transforms of length `span` into transforms of length R * span. Results are passed
+// to the sink, which either stores them back to the work buffer or writes the final output.
+template <size_t R, typename Sink>
+void run_stage(float* work, size_t n, size_t span, const float* twiddles, bool inverse, const Sink& sink) {
+    cvec y[R];
+    for (size_t base = 0; base < n; base += R * span) {
+        for (size_t j = 0; j < span; ++j) {
+            for (size_t q = 0; q < R; ++q)
+                y[q] = load_block(work, base + j + q * span);
+
+            // The first element of a sub-transform always has unit twiddles
+            if (j != 0) {
+                const float* w = twiddles + 2 * (R - 1) * j;
+                for (size_t q = 1; q < R; ++q)
+                    y[q] = cmul(y[q], vset1(w[2 * q - 2]), vset1(w[2 * q - 1]));
+            }
+
+            butterfly<R>(y, inverse);
+
+            for (size_t q = 0; q < R; ++q)
+                sink(base + j + q * span, y[q]);
+        }
+    }
+}
+
+//
+// Sources and sinks of the transforms
+//
+
+struct WorkStore {
+    float* work;
+    void operator()(size_t k, const cvec& y) const {
+        store_block(work, k, y);
+    }
+};
+
+// All the lanes are in use and the signals are adjacent in memory
+template <typename T>
+struct PackedLoad {
+    const T* data;
+    ptrdiff_t stride;
+    cvec operator()(size_t k) const {
+        cvec y;
+        load_complex(data + 2 * static_cast<ptrdiff_t>(k) * stride, y.re, y.im);
+        return y;
+    }
+};
+
+template <typename T>
+struct PackedStore {
+    T* data;
+    ptrdiff_t stride;
+    vec_t scale;
+    void operator()(size_t k, const cvec& y) const {
+        store_complex(data + 2 * static_cast<ptrdiff_t>(k) * stride, vmul(y.re, scale), vmul(y.im, scale));
+    }
+};
+
+// Signals which are not adjacent in memory go through a tile in the work buffer layout. The tile is
+// filled and drained in chunks, so every signal is accessed sequentially while the chunk stays in L1.
+constexpr size_t tile_chunk = 64;
+
+template <typename T>
+void tile_in(float* tile, const T* data, ptrdiff_t stride, ptrdiff_t dist, size_t count, size_t n) {
+    if (count < vec_width) {
+        for (size_t k = 0; k < n; ++k) {
+            std::fill_n(tile + k * block_size + count, vec_width - count, 0.0f);
+            std::fill_n(tile + k * block_size + vec_width + count, vec_width - count, 0.0f);
+        }
+    }
+    for (size_t k0 = 0; k0 < n; k0 += tile_chunk) {
+        const size_t k1 = std::min(n, k0 + tile_chunk);
+        for (size_t l = 0; l < count; ++l) {
+            const T* src = data + 2 * static_cast<ptrdiff_t>(l) * dist;
+            for (size_t k = k0; k < k1; ++k) {
+                tile[k * block_size + l] = static_cast<float>(src[2 * static_cast<ptrdiff_t>(k) * stride]);
+                tile[k * block_size + vec_width + l] = static_cast<float>(src[2 * static_cast<ptrdiff_t>(k) * stride + 1]);
+            }
+        }
+    }
+}
+
+template <typename T>
+void tile_out(const float* tile, T* data, ptrdiff_t stride, ptrdiff_t dist, size_t count, size_t n, float scale) {
+    for (size_t k0 = 0; k0 < n; k0 += tile_chunk) {
+        const size_t k1 = std::min(n, k0 + tile_chunk);
+        for (size_t l = 0; l < count; ++l) {
+            T* dst = data + 2 * static_cast<ptrdiff_t>(l) * dist;
+            for (size_t k = k0; k < k1; ++k) {
+                dst[2 * static_cast<ptrdiff_t>(k) * stride] = T(tile[k * block_size + l] * scale);
+                dst[2 * static_cast<ptrdiff_t>(k) * stride + 1] = T(tile[k * block_size + vec_width + l] * scale);
+            }
+        }
+    }
+}
+
+struct TileLoad {
+    const float* tile;
+    cvec operator()(size_t k) const {
+        return load_block(tile, k);
+    }
+};
+
+// Packs real signals l and l + vec_width into the real and imaginary parts of lane l
+template <typename T>
+struct RealPairLoad {
+    const T* data;
+    ptrdiff_t stride;
+    ptrdiff_t dist;
+    size_t count;
+    cvec operator()(size_t k) const {
+        const T* src = data + static_cast<ptrdiff_t>(k) * stride;
+        if (dist == 1 && count == 2 * vec_width) {
+            cvec y;
+            load_values(src, y.re);
+            load_values(src + vec_width, y.im);
+            return y;
+        }
+        float lanes[block_size] = {};
+        for (size_t l = 0; l < count; ++l)
+            lanes[l] = static_cast<float>(src[static_cast<ptrdiff_t>(l) * dist]);
+        return load_block(lanes, 0);
+    }
+};
+
+// Unpacks the real and imaginary parts of lane l into real signals l and l + vec_width
+template <typename T>
+struct RealPairStore {
+    T* data;
+    ptrdiff_t stride;
+    ptrdiff_t dist;
+    size_t count;
+    vec_t scale;
+    void operator()(size_t k, const cvec& y) const {
+        T* dst = data + static_cast<ptrdiff_t>(k) * stride;
+        if (dist == 1 && count == 2 * vec_width) {
+            store_values(dst, vmul(y.re, scale));
+            store_values(dst + vec_width, vmul(y.im, scale));
+            return;
+        }
+        float lanes[block_size];
+        store_block(lanes, 0, cscale(y, scale));
+        for (size_t l = 0; l < count; ++l)
+            dst[static_cast<ptrdiff_t>(l) * dist] = T(lanes[l]);
+    }
+};
+
+// Packs two Hermitian half-spectra X (signal l) and Y (signal l + vec_width) into the full spectrum
+// of the complex signal x + i * y
+template <typename T>
+struct HermitianPairLoad {
+    const T* data;
+    ptrdiff_t stride;
+    ptrdiff_t dist;
+    size_t count;
+    size_t n;
+    cvec operator()(size_t k) const {
+        const bool mirrored = 2 * k > n;
+        const size_t bin = mirrored ? n - k : k;
+        const T* src = data + 2 * static_cast<ptrdiff_t>(bin) * stride;
+        float lanes[2 * block_size] = {};
+        for (size_t l = 0; l < count; ++l) {
+            lanes[(l / vec_width) * block_size + l % vec_width] = static_cast<float>(src[2 * static_cast<ptrdiff_t>(l) * dist]);
+            lanes[(l / vec_width) * block_size + vec_width + l % vec_width] =
+                static_cast<float>(src[2 * static_cast<ptrdiff_t>(l) * dist + 1]);
+        }
+        cvec x = load_block(lanes, 0);
+        cvec y = load_block(lanes, 1);
+        if (mirrored) {
+            x = cconj(x);
+            y = cconj(y);
+        } else if (k == 0 || 2 * k == n) {
+            // Imaginary parts of the DC and Nyquist bins do not contribute to a real signal
+            x.im = vset1(0.0f);
+            y.im = vset1(0.0f);
+        }
+        return {vsub(x.re, y.im), vadd(x.im, y.re)};
+    }
+};
+
+// Rotates the output indices of a centered transform
+template <typename Sink>
+struct ShiftedStore {
+    const Sink& sink;
+    size_t shift;
+    size_t n;
+    void operator()(size_t k, const cvec& y) const {
+        k += shift;
+        sink(k < n ? k : k - n, y);
+    }
+};
+
+// Multiplies the loaded input by the chirp and pads it with zeros up to the convolution length
+template <typename Load>
+struct ChirpLoad {
+    const Load& load;
+    const float* chirp;
+    size_t shift;
+    size_t n;
+    cvec operator()(size_t k) const {
+        if (k >= n)
+            return {vset1(0.0f), vset1(0.0f)};
+        const size_t src = k + shift;
+        return cmul(load(src < n ? src : src - n), vset1(chirp[2 * k]), vset1(chirp[2 * k + 1]));
+    }
+};
+
+// Multiplies the spectrum by the kernel spectrum and conjugates it so that the inverse transform
+// can be computed as conj(FFT(conj(x)))
+struct KernelLoad {
+    const float* work;
+    const float* kernel;
+    cvec operator()(size_t k) const {
+        return cconj(cmul(load_block(work, k), vset1(kernel[2 * k]), vset1(kernel[2 * k + 1])));
+    }
+};
+
+// Drops the convolution tail and multiplies the result by the chirp
+template <typename Sink>
+struct ChirpStore {
+    const Sink& sink;
+    const float* chirp;
+    size_t n;
+    void operator()(size_t k, const cvec& y) const {
+        if (k < n)
+            sink(k, cmul(cconj(y), vset1(chirp[2 * k]), vset1(chirp[2 * k + 1])));
+    }
+};
+
+}  // namespace
+
+// Transforms of a plan with vectors of this instruction set, see Plan for the arguments
+struct Kernels {
+    static size_t lanes() {
+        return vec_width;
+    }
+
+    template <typename T>
+    static void transform(const Plan& plan,
+                          const T* in,
+                          ptrdiff_t in_stride,
+                          ptrdiff_t in_dist,
+                          T* out,
+                          ptrdiff_t out_stride,
+                          ptrdiff_t out_dist,
+                          size_t count,
+                          float scale,
+                          float* scratch) {
+        const size_t n = plan.n;
+        const bool packed_in = count == vec_width && in_dist == 1;
+        const bool packed_out = count == vec_width && out_dist == 1;
+        const vec_t factor = vset1(scale);
+        float* tile = scratch + (plan.conv ? 2 * plan.conv->length() : n) * block_size;
+
+        if (!packed_in)
+            tile_in(tile, in, in_stride, in_dist, count, n);
+
+        if (packed_in && packed_out) {
+            execute(plan, PackedLoad<T>{in, in_stride}, PackedStore<T>{out, out_stride, factor}, scratch);
+        } else if (packed_in) {
+            execute(plan, PackedLoad<T>{in, in_stride}, WorkStore{tile}, scratch);
+        } else if (packed_out) {
+            execute(plan, TileLoad{tile}, PackedStore<T>{out, out_stride, factor}, scratch);
+        } else {
+            execute(plan, TileLoad{tile}, WorkStore{tile}, scratch);
+        }
+
+        if (!packed_out)
+            tile_out(tile, out, out_stride, out_dist, count, n, scale);
+    }
+
+    template <typename T>
+    static void transform_real(const Plan& plan,
+                               const T* in,
+                               ptrdiff_t in_stride,
+                               ptrdiff_t in_dist,
+                               T* out,
+                               ptrdiff_t out_stride,
+                               ptrdiff_t out_dist,
+                               size_t count,
+                               float scale,
+                               float* scratch) {
+        const size_t n = plan.n;
+        float* spectrum = plan.conv ? scratch + 2 * plan.conv->length() * block_size : scratch;
+        execute(plan, RealPairLoad<T>{in, in_stride, in_dist, count}, WorkStore{spectrum}, scratch);
+
+        // Z = X + i * Y, so X[k] = (Z[k] + conj(Z[n - k])) / 2 and Y[k] = (Z[k] - conj(Z[n - k])) / 2i
+        const vec_t half = vset1(0.5f * scale);
+        float lanes[2 * block_size];
+        for (size_t k = 0; k <= n / 2; ++k) {
+            const cvec z = load_block(spectrum, k);
+            const cvec w = load_block(spectrum, k == 0 ? 0 : n - k);
+            store_block(lanes, 0, {vmul(vadd(z.re, w.re), half), vmul(vsub(z.im, w.im), half)});
+            store_block(lanes, 1, {vmul(vadd(z.im, w.im), half), vmul(vsub(w.re, z.re), half)});
+
+            T* dst = out + 2 * static_cast<ptrdiff_t>(k) * out_stride;
+            for (size_t l = 0; l < count; ++l) {
+                dst[2 * static_cast<ptrdiff_t>(l) * out_dist] = T(lanes[(l / vec_width) * block_size + l % vec_width]);
+                dst[2 * static_cast<ptrdiff_t>(l) * out_dist + 1] =
+                    T(lanes[(l / vec_width) * block_size + vec_width + l % vec_width]);
+            }
+        }
+    }
+
+    template <typename T>
+    static void transform_hermitian(const Plan& plan,
+                                    const T* in,
+                                    ptrdiff_t in_stride,
+                                    ptrdiff_t in_dist,
+                                    T* out,
+                                    ptrdiff_t out_stride,
+                                    ptrdiff_t out_dist,
+                                    size_t count,
+                                    float scale,
+                                    float* scratch) {
+        execute(plan,
+                HermitianPairLoad<T>{in, in_stride, in_dist, count, plan.n},
+                RealPairStore<T>{out, out_stride, out_dist, count, vset1(scale)},
+                scratch);
+    }
+
+private:
+    template <typename Load>
+    static void gather(const Plan& plan, float* work, const Load& load) {
+        for (size_t k = 0; k < plan.n; ++k)
+            store_block(work, k, load(plan.perm[k]));
+    }
+
+    template <typename Sink>
+    static void run_stages(const Plan& plan, float* work, const Sink& sink) {
+        const size_t n = plan.n;
+        const bool inverse = plan.inverse;
+        if (plan.stages.empty()) {
+            sink(0, load_block(work, 0));
+            return;
+        }
+        const WorkStore store{work};
+        for (size_t s = 0; s < plan.stages.size(); ++s) {
+            const Plan::Stage& stage = plan.stages[s];
+            const float* tw = plan.twiddles.data() + stage.twiddles;
+            const bool last = s + 1 == plan.stages.size();
+            switch (stage.radix) {
+            case 2:
+                last ? run_stage<2>(work, n, stage.span, tw, inverse, sink)
+                     : run_stage<2>(work, n, stage.span, tw, inverse, store);
+                break;
+            case 3:
+                last ? run_stage<3>(work, n, stage.span, tw, inverse, sink)
+                     : run_stage<3>(work, n, stage.span, tw, inverse, store);
+                break;
+            case 4:
+                last ? run_stage<4>(work, n, stage.span, tw, inverse, sink)
+                     : run_stage<4>(work, n, stage.span, tw, inverse, store);
+                break;
+            default:
+                last ? run_stage<5>(work, n, stage.span, tw, inverse, sink)
+                     : run_stage<5>(work, n, stage.span, tw, inverse, store);
+                break;
+            }
+        }
+    }
+
+    template <typename Load, typename Sink>
+    static void execute(const Plan& plan, const Load& load, const Sink& sink, float* scratch) {
+        if (plan.shift) {
+            execute_shifted(plan, load, ShiftedStore<Sink>{sink, plan.shift, plan.n}, scratch);
+        } else {
+            execute_shifted(plan, load, sink, scratch);
+        }
+    }
+
+    // The input shift is a part of the gather permutation (or of the chirp load for Bluestein plans),
+    // so only the output indices have to be rotated by the sink.
+    template <typename Load, typename Sink>
+    static void execute_shifted(const Plan& plan, const Load& load, const Sink& sink, float* scratch) {
+        if (!plan.conv) {
+            gather(plan, scratch, load);
+            run_stages(plan, scratch, sink);
+            return;
+        }
+        const Plan& conv = *plan.conv;
+        float* spectrum = scratch;
+        float* product = scratch + conv.length() * block_size;
+        gather(conv, spectrum, ChirpLoad<Load>{load, plan.chirp.data(), plan.shift, plan.n});
+        run_stages(conv, spectrum, WorkStore{spectrum});
+        gather(conv, product, KernelLoad{spectrum, plan.kernel.data()});
+        run_stages(conv, product, ChirpStore<Sink>{sink, plan.chirp.data(), plan.n});
+    }
+};
+
+}  // namespace FFT_KERNELS_NAMESPACE
+}  // namespace fft_engine
+}  // namespace TemplateExtension
@@ -0,0 +1,310 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "spectral_filter.hpp"
+#include "fft_engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <openvino/core/parallel.hpp>
+#include <openvino/core/type/bfloat16.hpp>
+#include <openvino/core/type/float16.hpp>
+#include <openvino/op/util/attr_types.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Tensor dimensions without the trailing 2 of complex values. Every slice holds the elements of the signal axes
+// for fixed indices of the other (batch) axes. Strides count complex numbers and are 0 along broadcasted axes.
+struct SliceLayout {
+    std::vector<size_t> dims;  // signal dimensions of a slice, the slice buffer is dense in this order
+    size_t size;               // complex numbers in a slice
+    size_t rows;               // slice rows along the innermost signal axis
+
+    // Offsets of the slice rows, the elements of a row are inner_stride apart
+    std::vector<size_t> inpRows, filterRows, outRows;
+    size_t inpInnerStride, filterInnerStride, outInnerStride;
+
+    // Batch axes
+    std::vector<size_t> batchDims;
+    std::vector<size_t> inpBatchStrides, filterBatchStrides, outBatchStrides;
+    size_t numSlices;
+};
+
+// Shape left-padded with ones to `rank` axes
+std::vector<size_t> pad_dims(const ov::Shape& shape, size_t rank) {
+    std::vector<size_t> dims(rank - (shape.size() - 1), 1);
+    dims.insert(dims.end(), shape.begin(), shape.end() - 1);
+    return dims;
+}
+
+std::vector<size_t> make_strides(const std::vector<size_t>& dims) {
+    std::vector<size_t> strides(dims.size());
+    size_t size = 1;
+    for (size_t i = dims.size(); i-- > 0;) {
+        strides[i] = dims[i] == 1 ? 0 : size;
+        size *= dims[i];
+    }
+    return strides;
+}
+
+SliceLayout make_layout(const ov::Shape& inpShape,
+                        const ov::Shape& filterShape,
+                        const ov::Shape& outShape,
+                        const std::vector<size_t>& axes) {
+    const size_t rank = outShape.size() - 1;
+    const std::vector<size_t> inpDims = pad_dims(inpShape, rank);
+    const std::vector<size_t> filterDims = pad_dims(filterShape, rank);
+    const std::vector<size_t> outDims = pad_dims(outShape, rank);
+    const std::vector<size_t> inpStrides = make_strides(inpDims);
+    const std::vector<size_t> filterStrides = make_strides(filterDims);
+    const std::vector<size_t> outStrides = make_strides(outDims);
+
+    SliceLayout layout;
+    std::vector<size_t> inpSignalStrides, filterSignalStrides, outSignalStrides;
+    for (size_t i = 0; i < rank; ++i) {
+        if (std::find(axes.begin(), axes.end(), i) != axes.end()) {
+            layout.dims.push_back(outDims[i]);
+            inpSignalStrides.push_back(inpStrides[i]);
+            filterSignalStrides.push_back(filterStrides[i]);
+            outSignalStrides.push_back(outStrides[i]);
+        } else {
+            layout.batchDims.push_back(outDims[i]);
+            layout.inpBatchStrides.push_back(inpStrides[i]);
+            layout.filterBatchStrides.push_back(filterStrides[i]);
+            layout.outBatchStrides.push_back(outStrides[i]);
+        }
+    }
+
+    layout.size = ov::shape_size(layout.dims);
+    layout.rows = layout.size / layout.dims.back();
+    layout.numSlices = ov::shape_size(layout.batchDims);
+    layout.inpInnerStride = inpSignalStrides.back();
+    layout.filterInnerStride = filterSignalStrides.back();
+    layout.outInnerStride = outSignalStrides.back();
+
+    std::vector<size_t> index(layout.dims.size() - 1, 0);
+    for (size_t r = 0; r < layout.rows; ++r) {
+        size_t inpOffset = 0, filterOffset = 0, outOffset = 0;
+        for (size_t i = 0; i < index.size(); ++i) {
+            inpOffset += index[i] * inpSignalStrides[i];
+            filterOffset += index[i] * filterSignalStrides[i];
+            outOffset += index[i] * outSignalStrides[i];
+        }
+        layout.inpRows.push_back(inpOffset);
+        layout.filterRows.push_back(filterOffset);
+        layout.outRows.push_back(outOffset);
+        for (size_t i = index.size(); i-- > 0 && ++index[i] == layout.dims[i];)
+            index[i] = 0;
+    }
+    return layout;
+}
+
+template <typename F>
+void for_each_task(bool parallel, size_t count, const F& func) {
+    if (parallel) {
+        ov::parallel_for(count, func);
+    } else {
+        for (size_t i = 0; i < count; ++i)
+            func(i);
+    }
+}
+
+// In-place transform of a dense slice along its signal axis `axis`, batched the same way as the FFT passes
+void run_slice_pass(float* slice,
+                    const std::vector<size_t>& dims,
+                    size_t axis,
+                    const fft_engine::Plan& plan,
+                    bool parallel) {
+    const size_t length = dims[axis];
+    size_t stride = 1, outer = 1;
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (i < axis)
+            outer *= dims[i];
+        else if (i > axis)
+            stride *= dims[i];
+    }
+
+    // Neighbour signals are adjacent in memory, along the innermost axis the signals of different rows go together
+    const size_t inner = stride != 1 ? stride : outer;
+    const size_t dist = stride != 1 ? 1 : length;
+    const size_t outerStride = stride != 1 ? length * stride : 0;
+    outer = stride != 1 ? outer : 1;
+
+    const size_t lanes = fft_engine::Plan::lanes();
+    const size_t groups = (inner + lanes - 1) / lanes;
+    const float scale = 1.0f / std::sqrt(static_cast<float>(length));
+    for_each_task(parallel, outer * groups, [&](size_t d) {
+        const size_t o = d / groups;
+        const size_t i = (d % groups) * lanes;
+        float* signal = slice + 2 * (o * outerStride + i * dist);
+        plan.transform(signal, stride, dist, signal, stride, dist, std::min(lanes, inner - i), scale,
+                       fft_engine::get_scratch(plan.scratch_size()));
+    });
+}
+
+// Slice buffer of the calling thread, it only grows
+float* get_slice_buffer(size_t size) {
+    static thread_local std::vector<float> buffer;
+    if (buffer.size() < size)
+        buffer.resize(size);
+    return buffer.data();
+}
+
+template <typename T>
+void spectral_filter(const T* inp,
+                     const T* filter,
+                     T* out,
+                     const SliceLayout& layout,
+                     bool centered) {
+    std::vector<std::shared_ptr<const fft_engine::Plan>> forward, inverse;
+    for (size_t length : layout.dims) {
+        forward.push_back(fft_engine::get_plan(length, false, centered));
+        inverse.push_back(fft_engine::get_plan(length, true, centered));
+    }
+
+    const size_t length = layout.dims.back();
+    auto process = [&](size_t s, float* slice, bool parallel) {
+        size_t inpBase = 0, filterBase = 0, outBase = 0;
+        for (size_t i = layout.batchDims.size(), rest = s; i-- > 0;) {
+            const size_t index = rest % layout.batchDims[i];
+            rest /= layout.batchDims[i];
+            inpBase += index * layout.inpBatchStrides[i];
+            filterBase += index * layout.filterBatchStrides[i];
+            outBase += index * layout.outBatchStrides[i];
+        }
+
+        for_each_task(parallel, layout.rows, [&](size_t r) {
+            const T* src = inp + 2 * (inpBase + layout.inpRows[r]);
+            float* dst = slice + 2 * r * length;
+            for (size_t j = 0; j < length; ++j) {
+                dst[2 * j] = static_cast<float>(src[2 * j * layout.inpInnerStride]);
+                dst[2 * j + 1] = static_cast<float>(src[2 * j * layout.inpInnerStride + 1]);
+            }
+        });
+
+        for (size_t axis = 0; axis < layout.dims.size(); ++axis)
+            run_slice_pass(slice, layout.dims, axis, *forward[axis], parallel);
+
+        for_each_task(parallel, layout.rows, [&](size_t r) {
+            const T* h = filter + 2 * (filterBase + layout.filterRows[r]);
+            float* x = slice + 2 * r * length;
+            for (size_t j = 0; j < length; ++j) {
+                const float real0 = x[2 * j];
+                const float imag0 = x[2 * j + 1];
+                const float real1 = static_cast<float>(h[2 * j * layout.filterInnerStride]);
+                const float imag1 = static_cast<float>(h[2 * j * layout.filterInnerStride + 1]);
+                x[2 * j] = real0 * real1 - imag0 * imag1;
+                x[2 * j + 1] = real0 * imag1 + imag0 * real1;
+            }
+        });
+
+        for (size_t axis = 0; axis < layout.dims.size(); ++axis)
+            run_slice_pass(slice, layout.dims, axis, *inverse[axis], parallel);
+
+        for_each_task(parallel, layout.rows, [&](size_t r) {
+            const float* src = slice + 2 * r * length;
+            T* dst = out + 2 * (outBase + layout.outRows[r]);
+            for (size_t j = 0; j < length; ++j) {
+                dst[2 * j * layout.outInnerStride] = T(src[2 * j]);
+                dst[2 * j * layout.outInnerStride + 1] = T(src[2 * j + 1]);
+            }
+        });
+    };
+
+    if (layout.numSlices >= static_cast<size_t>(ov::parallel_get_max_threads())) {
+        // Every slice is processed by a single thread from the start to the end
+        ov::parallel_for(layout.numSlices, [&](size_t s) {
+            process(s, get_slice_buffer(2 * layout.size), false);
+        });
+    } else {
+        // Too few slices to occupy the threads: slices go one by one, all the threads work on each of them
+        std::vector<float> slice(2 * layout.size);
+        for (size_t s = 0; s < layout.numSlices; ++s)
+            process(s, slice.data(), true);
+    }
+}
+
+}  // namespace
+
+SpectralFilter::SpectralFilter(const ov::OutputVector& args, bool centered) : Op(args), centered(centered) {
+    constructor_validate_and_infer_types();
+}
+
+void SpectralFilter::validate_and_infer_types() {
+    // The filter is broadcasted to the spectrum the same way ComplexMultiplication broadcasts its inputs
+    auto outShape = get_input_partial_shape(0);
+    const auto& filterShape = get_input_partial_shape(2);
+    for (const auto& shape : {outShape, filterShape}) {
+        OPENVINO_ASSERT(shape.rank().is_dynamic() || (shape.rank().get_length() > 0 && shape[shape.size() - 1].compatible(2)),
+                        "SpectralFilter data and filter must have a trailing axis of 2 complex components");
+    }
+    OPENVINO_ASSERT(ov::PartialShape::broadcast_merge_into(outShape, filterShape, ov::op::AutoBroadcastType::NUMPY),
+                    "SpectralFilter data and filter are not broadcastable");
+    set_output_type(0, get_input_element_type(0), outShape);
+}
+
+std::shared_ptr<ov::Node> SpectralFilter::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 3, "Incorrect number of new arguments");
+    return std::make_shared<SpectralFilter>(new_args, centered);
+}
+
+bool SpectralFilter::visit_attributes(ov::AttributeVisitor& visitor) {
+    int centered_i = static_cast<int>(centered);
+    visitor.on_attribute("centered", centered_i);
+    centered = static_cast<bool>(centered_i);
+    return true;
+}
+
+bool SpectralFilter::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    if (inputs[1].get_element_type() != ov::element::i32)
+        OPENVINO_THROW("Unexpected dims type: " + inputs[1].get_element_type().to_string());
+
+    const ov::Shape& inpShape = inputs[0].get_shape();
+    const ov::Shape& outShape = outputs[0].get_shape();
+    const int32_t* signalDimsData = reinterpret_cast<const int32_t*>(inputs[1].data());
+    const size_t numSignalDims = inputs[1].get_shape()[0];
+
+    // Signal axes are given for the data, the filter may add leading axes to the output
+    const int64_t inpRank = static_cast<int64_t>(inpShape.size()) - 1;
+    const size_t shift = outShape.size() - inpShape.size();
+    OPENVINO_ASSERT(numSignalDims > 0, "SpectralFilter requires at least one signal axis");
+    std::vector<size_t> axes;
+    for (size_t i = 0; i < numSignalDims; ++i) {
+        const int64_t axis = signalDimsData[i] < 0 ? signalDimsData[i] + inpRank : signalDimsData[i];
+        OPENVINO_ASSERT(0 <= axis && axis < inpRank,
+                        "Signal axis ", signalDimsData[i], " is out of range for ", inpRank, "D signal");
+        OPENVINO_ASSERT(std::find(axes.begin(), axes.end(), static_cast<size_t>(axis) + shift) == axes.end(),
+                        "Signal axis ", signalDimsData[i], " is repeated");
+        OPENVINO_ASSERT(inpShape[axis] == outShape[axis + shift],
+                        "SpectralFilter filter cannot broadcast the data along signal axis ", signalDimsData[i]);
+        axes.push_back(static_cast<size_t>(axis) + shift);
+    }
+
+    const SliceLayout layout = make_layout(inpShape, inputs[2].get_shape(), outShape, axes);
+    const auto type = inputs[0].get_element_type();
+    if (type == ov::element::f32)
+        spectral_filter(reinterpret_cast<const float*>(inputs[0].data()), reinterpret_cast<const float*>(inputs[2].data()),
+                        reinterpret_cast<float*>(outputs[0].data()), layout, centered);
+    else if (type == ov::element::f16)
+        spectral_filter(reinterpret_cast<const ov::float16*>(inputs[0].data()),
+                        reinterpret_cast<const ov::float16*>(inputs[2].data()),
+                        reinterpret_cast<ov::float16*>(outputs[0].data()), layout, centered);
+    else if (type == ov::element::bf16)
+        spectral_filter(reinterpret_cast<const ov::bfloat16*>(inputs[0].data()),
+                        reinterpret_cast<const ov::bfloat16*>(inputs[2].data()),
+                        reinterpret_cast<ov::bfloat16*>(outputs[0].data()), layout, centered);
+    else
+        OPENVINO_THROW("Unexpected input type: " + type.to_string());
+    return true;
+}
+
+bool SpectralFilter::has_evaluate() const {
+    const auto type = get_input_element_type(0);
+    if (type != ov::element::f32 && type != ov::element::f16 && type != ov::element::bf16)
+        return false;
+    return get_input_element_type(1) == ov::element::i32 && get_input_element_type(2) == type;
+}
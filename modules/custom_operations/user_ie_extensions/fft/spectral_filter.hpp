@@ -0,0 +1,33 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+// Inverse FFT of the product of FFT(data) and a spectral filter: FFT -> ComplexMultiplication -> inverse FFT
+// computed as a single operation. Inputs are the complex data, the signal axes and the complex filter which is
+// broadcasted to the spectrum NumPy-style. Every slice of the data along the signal axes is transformed,
+// multiplied and transformed back while it stays in cache, so no full size spectrum is ever stored.
+class SpectralFilter : public ov::op::Op {
+public:
+    OPENVINO_OP("SpectralFilter");
+
+    SpectralFilter() = default;
+    SpectralFilter(const ov::OutputVector& args, bool centered);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+private:
+    // Both transforms are centered
+    bool centered = false;
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,85 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "spectral_filter_fusion.hpp"
+#include "fft.hpp"
+#include "spectral_filter.hpp"
+#include "../complex_mul.hpp"
+
+#include <openvino/core/graph_util.hpp>
+#include <openvino/core/rt_info.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/pass/pattern/op/or.hpp>
+#include <openvino/pass/pattern/op/wrap_type.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Signal axes of a transform with negative values normalized by the data rank
+bool get_axes(const std::shared_ptr<FFT>& node, std::vector<int64_t>& axes) {
+    const auto dims = ov::as_type_ptr<ov::op::v0::Constant>(node->input_value(1).get_node_shared_ptr());
+    const auto& shape = node->get_input_partial_shape(0);
+    if (!dims || shape.rank().is_dynamic())
+        return false;
+
+    const int64_t rank = shape.rank().get_length() - 1;  // complex values
+    axes = dims->cast_vector<int64_t>();
+    for (auto& axis : axes) {
+        axis = axis < 0 ? axis + rank : axis;
+        if (axis < 0 || axis >= rank)
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+SpectralFilterFusion::SpectralFilterFusion() {
+    using namespace ov::pass::pattern;
+
+    auto forward = wrap_type<FFT>({any_input(), wrap_type<ov::op::v0::Constant>()}, consumers_count(1));
+    auto filter = any_input();
+    // The spectrum may be either of the factors
+    auto mul = std::make_shared<ov::pass::pattern::op::Or>(ov::OutputVector{
+        wrap_type<ComplexMultiplication>({forward, filter}, consumers_count(1)),
+        wrap_type<ComplexMultiplication>({filter, forward}, consumers_count(1))});
+    auto inverse = wrap_type<FFT>({mul, wrap_type<ov::op::v0::Constant>()});
+
+    ov::matcher_pass_callback callback = [=](Matcher& m) {
+        const auto& patternMap = m.get_pattern_value_map();
+        const auto forwardNode = ov::as_type_ptr<FFT>(patternMap.at(forward).get_node_shared_ptr());
+        const auto inverseNode = ov::as_type_ptr<FFT>(patternMap.at(inverse).get_node_shared_ptr());
+        if (!forwardNode || !inverseNode || forwardNode->is_real() || inverseNode->is_real() ||
+            forwardNode->get_inverse() || !inverseNode->get_inverse() ||
+            forwardNode->get_centered() != inverseNode->get_centered())
+            return false;
+
+        const auto mulNode = inverseNode->get_input_node_shared_ptr(0);
+        std::vector<int64_t> forwardAxes, inverseAxes;
+        if (!get_axes(forwardNode, forwardAxes) || !get_axes(inverseNode, inverseAxes) ||
+            forwardAxes.size() != inverseAxes.size())
+            return false;
+
+        // Broadcasting may add leading axes to the spectrum, but must keep the lengths of the transformed ones
+        const auto& dataShape = forwardNode->get_input_partial_shape(0);
+        const auto& outShape = mulNode->get_output_partial_shape(0);
+        const int64_t shift = outShape.rank().get_length() - dataShape.rank().get_length();
+        for (size_t i = 0; i < forwardAxes.size(); ++i) {
+            const int64_t axis = forwardAxes[i];
+            if (inverseAxes[i] != axis + shift || dataShape[axis].is_dynamic() || dataShape[axis] != outShape[axis + shift])
+                return false;
+        }
+
+        auto fused = std::make_shared<SpectralFilter>(
+            ov::OutputVector{forwardNode->input_value(0), forwardNode->input_value(1), patternMap.at(filter)},
+            forwardNode->get_centered());
+        fused->set_friendly_name(inverseNode->get_friendly_name());
+        ov::copy_runtime_info({forwardNode, mulNode, inverseNode}, fused);
+        ov::replace_node(inverseNode, fused);
+        return true;
+    };
+
+    register_matcher(std::make_shared<Matcher>(inverse, "SpectralFilterFusion"), callback);
+}
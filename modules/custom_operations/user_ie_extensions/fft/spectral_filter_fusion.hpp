@@ -0,0 +1,20 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/pass/graph_rewrite.hpp>
+
+namespace TemplateExtension {
+
+// Replaces FFT -> ComplexMultiplication -> inverse FFT over the same signal axes with SpectralFilter.
+// The intermediate spectra must have no other consumers, the filter must not broadcast the data along
+// its signal axes.
+class SpectralFilterFusion : public ov::pass::MatcherPass {
+public:
+    OPENVINO_RTTI("SpectralFilterFusion", "0");
+    SpectralFilterFusion();
+};
+
+}  // namespace TemplateExtension
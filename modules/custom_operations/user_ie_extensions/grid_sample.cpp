@@ -3,15 +3,155 @@
 //
 
 #include "grid_sample.hpp"
+#include "cpu_isa.hpp"
+
+#include <cmath>
+#include <limits>
+
 #include <openvino/core/parallel.hpp>
 
 using namespace TemplateExtension;
 
-GridSample::GridSample(const ov::OutputVector& args) : Op(args) {
+namespace {
+
+enum class Padding { zeros, border, reflection };
+
+// Maps a sampling coordinate into [0, size - 1] for the border and reflection modes. Reflection mirrors
+// about the centers of the border pixels, so the period is 2 * (size - 1).
+float pad_coordinate(float v, size_t size, Padding padding) {
+    const float last = static_cast<float>(size - 1);
+    if (padding == Padding::reflection) {
+        if (size == 1)
+            return 0.0f;
+        v = std::fabs(v);
+        const float flips = std::floor(v / last);
+        const float extra = v - flips * last;
+        v = std::fmod(flips, 2.0f) == 0.0f ? extra : last - extra;
+    }
+    if (padding != Padding::zeros)
+        v = std::min(std::max(v, 0.0f), last);
+    return v;
+}
+
+// Bilinear taps of a row of output pixels, computed once and shared by all the channels. Tap k of pixel x
+// reads the input plane at idx[k][x] with weight w[k][x], taps ordered as (y0, x0), (y0, x1), (y1, x0), (y1, x1).
+// Taps outside of the input get zero weights and clamped indices, so every load stays in bounds and the
+// zeros padding needs no separate code path.
+struct RowTaps {
+    std::vector<int32_t> idx[4];
+    std::vector<float> w[4];
+
+    void compute(const float* grid, size_t width, size_t inpWidth, size_t inpHeight, Padding padding) {
+        for (size_t k = 0; k < 4; ++k) {
+            idx[k].resize(width);
+            w[k].resize(width);
+        }
+        for (size_t x = 0; x < width; ++x) {
+            // Coordinates beyond a pixel from the border sample nothing, limit them before the integer conversion
+            float input_x = pad_coordinate(0.5f * (grid[x * 2] + 1) * (inpWidth - 1), inpWidth, padding);
+            float input_y = pad_coordinate(0.5f * (grid[x * 2 + 1] + 1) * (inpHeight - 1), inpHeight, padding);
+            input_x = std::isnan(input_x) ? -2.0f : std::min(std::max(input_x, -2.0f), static_cast<float>(inpWidth) + 1);
+            input_y = std::isnan(input_y) ? -2.0f : std::min(std::max(input_y, -2.0f), static_cast<float>(inpHeight) + 1);
+
+            const int x0 = static_cast<int>(std::floor(input_x));
+            const int y0 = static_cast<int>(std::floor(input_y));
+            const float fx = input_x - x0;
+            const float fy = input_y - y0;
+
+            const int iw = static_cast<int>(inpWidth);
+            const int ih = static_cast<int>(inpHeight);
+            const float mx0 = (0 <= x0 && x0 < iw) ? 1.0f - fx : 0.0f;
+            const float mx1 = (0 <= x0 + 1 && x0 + 1 < iw) ? fx : 0.0f;
+            const float my0 = (0 <= y0 && y0 < ih) ? 1.0f - fy : 0.0f;
+            const float my1 = (0 <= y0 + 1 && y0 + 1 < ih) ? fy : 0.0f;
+            const int cx0 = std::min(std::max(x0, 0), iw - 1);
+            const int cx1 = std::min(std::max(x0 + 1, 0), iw - 1);
+            const int cy0 = std::min(std::max(y0, 0), ih - 1) * iw;
+            const int cy1 = std::min(std::max(y0 + 1, 0), ih - 1) * iw;
+
+            idx[0][x] = cy0 + cx0;
+            idx[1][x] = cy0 + cx1;
+            idx[2][x] = cy1 + cx0;
+            idx[3][x] = cy1 + cx1;
+            w[0][x] = my0 * mx0;
+            w[1][x] = my0 * mx1;
+            w[2][x] = my1 * mx0;
+            w[3][x] = my1 * mx1;
+        }
+    }
+};
+
+CPU_ISA_INLINE void interpolate_tail(const float* inp, const RowTaps& taps, size_t x, size_t width, float* out) {
+    for (; x < width; ++x) {
+        out[x] = taps.w[0][x] * inp[taps.idx[0][x]] + taps.w[1][x] * inp[taps.idx[1][x]] +
+                 taps.w[2][x] * inp[taps.idx[2][x]] + taps.w[3][x] * inp[taps.idx[3][x]];
+    }
+}
+
+// Interpolates a row of a single channel. Output pixels are contiguous in NCHW, so the vector lanes are pixels
+// and the taps are gathered from the input plane. Gathers come with AVX2, narrower instruction sets use the
+// scalar loop.
+#ifdef CPU_ISA_X86
+CPU_ISA_TARGET_AVX512 void interpolate_row_avx512(const float* inp, const RowTaps& taps, size_t width, float* out) {
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m512 acc = _mm512_setzero_ps();
+        for (size_t k = 0; k < 4; ++k) {
+            const __m512i idx = _mm512_loadu_si512(taps.idx[k].data() + x);
+            acc = _mm512_fmadd_ps(_mm512_loadu_ps(taps.w[k].data() + x), _mm512_i32gather_ps(idx, inp, 4), acc);
+        }
+        _mm512_storeu_ps(out + x, acc);
+    }
+    interpolate_tail(inp, taps, x, width, out);
+}
+
+CPU_ISA_TARGET_AVX2 void interpolate_row_avx2(const float* inp, const RowTaps& taps, size_t width, float* out) {
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (size_t k = 0; k < 4; ++k) {
+            const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(taps.idx[k].data() + x));
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(taps.w[k].data() + x), _mm256_i32gather_ps(inp, idx, 4), acc);
+        }
+        _mm256_storeu_ps(out + x, acc);
+    }
+    interpolate_tail(inp, taps, x, width, out);
+}
+#endif
+
+void interpolate_row_baseline(const float* inp, const RowTaps& taps, size_t width, float* out) {
+    interpolate_tail(inp, taps, 0, width, out);
+}
+
+using InterpolateKernel = void (*)(const float*, const RowTaps&, size_t, float*);
+
+InterpolateKernel select_interpolate_kernel() {
+    switch (get_cpu_isa()) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        return interpolate_row_avx512;
+    case CpuIsa::avx2:
+        return interpolate_row_avx2;
+#endif
+    default:
+        return interpolate_row_baseline;
+    }
+}
+
+// Chosen when the extension is loaded
+const InterpolateKernel interpolate_row = select_interpolate_kernel();
+
+}  // namespace
+
+GridSample::GridSample(const ov::OutputVector& args, const std::string& padding_mode)
+    : Op(args),
+      padding_mode(padding_mode) {
     constructor_validate_and_infer_types();
 }
 
 void GridSample::validate_and_infer_types() {
+    OPENVINO_ASSERT(padding_mode == "zeros" || padding_mode == "border" || padding_mode == "reflection",
+                    "Unsupported padding mode: ", padding_mode);
     auto outShape = get_input_partial_shape(0);  // NC
     // Grid input has a shape NxHxWx2
     auto gridShape = get_input_partial_shape(1);
@@ -22,7 +162,12 @@ void GridSample::validate_and_infer_types() {
 
 std::shared_ptr<ov::Node> GridSample::clone_with_new_inputs(const ov::OutputVector& new_args) const {
     OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
-    return std::make_shared<GridSample>(new_args);
+    return std::make_shared<GridSample>(new_args, padding_mode);
+}
+
+bool GridSample::visit_attributes(ov::AttributeVisitor& visitor) {
+    visitor.on_attribute("padding_mode", padding_mode);
+    return true;
 }
 
 bool GridSample::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
@@ -41,66 +186,22 @@ bool GridSample::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inp
     const size_t inpWidth  = inpDims[3];
     const size_t inpPlane  = inpHeight * inpWidth;
     const size_t outPlane  = height * width;
+    OPENVINO_ASSERT(inpPlane <= static_cast<size_t>(std::numeric_limits<int32_t>::max()), "GridSample input plane is too large");
 
-    std::vector<float> zerosPlane(inpDims[1] * inpDims[2] * inpDims[3], 0);
-    float* zeros = zerosPlane.data();
-
-    ov::parallel_for(batch, [&](size_t d) {
-        const float* inp  = inpData + d * channels * inpPlane;
-        const float* grid = gridData + d * outPlane * 2;
-        for (size_t y = 0; y < height; ++y) {
-            for (size_t x = 0; x < width; ++x) {
-                size_t offset = y * width + x;
-
-                float input_x = 0.5f * (grid[offset * 2] + 1) * (inpWidth - 1);
-                int x0 = static_cast<int>(std::floor(input_x));
-                int x1 = x0 + 1;
-
-                float input_y = 0.5f * (grid[offset * 2 + 1] + 1) * (inpHeight - 1);
-                int y0 = static_cast<int>(std::floor(input_y));
-                int y1 = y0 + 1;
-
-                const float* inp_row0 = (0 <= y0 && y0 < inpHeight) ? inp + y0 * inpWidth : zeros;
-                const float* inp_row1 = (0 <= y1 && y1 < inpHeight) ? inp + y1 * inpWidth : zeros;
-                float* out = outData + d * channels * outPlane;
-                if ((x1 < 0 || inpWidth <= x1) && (x0 < 0 || inpWidth <= x0)) {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] = 0;
-                        out += outPlane;
-                    }
-                }
-                else if (x1 < 0 || inpWidth <= x1) {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] = inp_row0[x0] +
-                            (input_y - y0) * (inp_row1[x0] - inp_row0[x0]) +
-                            (input_x - x0) * (-inp_row0[x0] +
-                            (input_y - y0) * (inp_row0[x0] - inp_row1[x0]));
-                        out += outPlane;
-                        inp_row0 += inpPlane;
-                        inp_row1 += inpPlane;
-                    }
-                }
-                else if (x0 < 0 || inpWidth <= x0) {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] =
-                            (input_x - x0) * (inp_row0[x1] + (input_y - y0) * (inp_row1[x1] - inp_row0[x1]));
-                        out += outPlane;
-                        inp_row0 += inpPlane;
-                        inp_row1 += inpPlane;
-                    }
-                } else {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] = inp_row0[x0] +
-                            (input_y - y0) * (inp_row1[x0] - inp_row0[x0]) +
-                            (input_x - x0) * (inp_row0[x1] - inp_row0[x0] +
-                            (input_y - y0) * (inp_row1[x1] - inp_row0[x1] - inp_row1[x0] + inp_row0[x0]));
-                        out += outPlane;
-                        inp_row0 += inpPlane;
-                        inp_row1 += inpPlane;
-                    }
-                }
-            }
-        }
+    const Padding padding = padding_mode == "border"       ? Padding::border
+                            : padding_mode == "reflection" ? Padding::reflection
+                                                           : Padding::zeros;
+
+    // Tap buffers are per thread and only grow, so repeated calls do not allocate.
+    // Every output row is a separate task, so batch 1 is spread over all the threads as well
+    ov::parallel_for2d(batch, height, [&](size_t d, size_t y) {
+        static thread_local RowTaps taps;
+        taps.compute(gridData + (d * height + y) * width * 2, width, inpWidth, inpHeight, padding);
+
+        const float* inp = inpData + d * channels * inpPlane;
+        float* out = outData + d * channels * outPlane + y * width;
+        for (size_t c = 0; c < channels; ++c)
+            interpolate_row(inp + c * inpPlane, taps, width, out + c * outPlane);
     });
     return true;
 }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string>
+
 #include <openvino/op/op.hpp>
 
 namespace TemplateExtension {
@@ -13,12 +15,17 @@ public:
     OPENVINO_OP("GridSample");
 
     GridSample() = default;
-    GridSample(const ov::OutputVector& new_args);
+    // padding_mode is one of "zeros", "border" or "reflection", as in torch.nn.functional.grid_sample
+    GridSample(const ov::OutputVector& new_args, const std::string& padding_mode = "zeros");
     void validate_and_infer_types() override;
     std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
 
     bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
     bool has_evaluate() const override;
+
+private:
+    std::string padding_mode = "zeros";
 };
 
 }  // namespace TemplateExtension
@@ -4,57 +4,391 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <openvino/core/except.hpp>
+#include <openvino/core/parallel.hpp>
 #include <openvino/runtime/tensor.hpp>
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#    include <string_view>
+#    define OPENVINO_EXTENSIONS_HAS_STRING_VIEW
+#endif
+
 namespace openvino_extensions {
+#ifdef OPENVINO_EXTENSIONS_HAS_STRING_VIEW
+using string_view = std::string_view;
+#else
+// Minimal read-only view of characters for C++11 and C++14 builds, std::string_view is used since C++17
+class string_view {
+public:
+    using value_type = char;
+    using const_iterator = const char*;
+    using iterator = const_iterator;
+
+    string_view() = default;
+    string_view(const char* data, size_t size) : m_data(data), m_size(size) {}
+    string_view(const std::string& str) : m_data(str.data()), m_size(str.size()) {}
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    size_t length() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const char* begin() const { return m_data; }
+    const char* end() const { return m_data + m_size; }
+    char operator[](size_t idx) const { return m_data[idx]; }
+
+    explicit operator std::string() const { return std::string(m_data, m_size); }
+
+    friend bool operator==(string_view lhs, string_view rhs) {
+        return lhs.m_size == rhs.m_size && (lhs.m_size == 0 || std::memcmp(lhs.m_data, rhs.m_data, lhs.m_size) == 0);
+    }
+    friend bool operator!=(string_view lhs, string_view rhs) { return !(lhs == rhs); }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
+#endif
+
+// Width of the string offsets of a packed tensor.
+// i32: [int32 batch size][int32 offsets, batch size + 1 of them][symbols], the format all consumers understand.
+// i64: [int32 -1][int32 64][int64 batch size][int64 offsets, batch size + 1 of them][symbols], for more than
+// 2 GiB of symbols. A negative first word is never a valid batch size, so the two formats cannot be confused.
+enum class string_offsets { i32, i64 };
+
+namespace strings_detail {
+
+constexpr int32_t wide_marker = -1;
+constexpr int32_t wide_bits = 64;
+
+inline size_t header_size(string_offsets format, size_t batch_size) {
+    return format == string_offsets::i32 ? 4 * (1 + 1 + batch_size) : 4 + 4 + 8 * (1 + 1 + batch_size);
+}
+
+// Resolves the format of a batch once the size of its symbols is known. The 32-bit format is kept whenever
+// the symbols fit, so the consumers of the original format keep working.
+inline string_offsets select_format(const string_offsets* requested, size_t symbols_size) {
+    const bool fits = symbols_size <= size_t(std::numeric_limits<int32_t>::max());
+    if (!requested)
+        return fits ? string_offsets::i32 : string_offsets::i64;
+    OPENVINO_ASSERT(*requested == string_offsets::i64 || fits,
+        "Strings of ", symbols_size, " bytes do not fit the packed string tensor with 32-bit offsets");
+    return *requested;
+}
+
+// Reshapes the tensor and writes the header, returns the offsets. The first offset is written as well.
+template <typename Offset>
+Offset* allocate(ov::Tensor& destination, string_offsets format, size_t batch_size, size_t symbols_size) {
+    destination.set_shape({header_size(format, batch_size) + symbols_size});
+    uint8_t* data = destination.data<uint8_t>();
+    Offset* offsets;
+    if (format == string_offsets::i32) {
+        int32_t* words = reinterpret_cast<int32_t*>(data);
+        words[0] = int32_t(batch_size);
+        offsets = reinterpret_cast<Offset*>(words + 1);
+    } else {
+        int32_t* words = reinterpret_cast<int32_t*>(data);
+        words[0] = wide_marker;
+        words[1] = wide_bits;
+        int64_t* wide = reinterpret_cast<int64_t*>(data + 8);
+        wide[0] = int64_t(batch_size);
+        offsets = reinterpret_cast<Offset*>(wide + 1);
+    }
+    offsets[0] = 0;
+    return offsets;
+}
+
+// Copies count strings starting at first to symbols + pos and writes their end offsets
+template <typename Offset, typename Iterator>
+void copy_strings(Iterator first, size_t count, size_t pos, Offset* ends, char* symbols) {
+    for (size_t idx = 0; idx < count; ++idx, ++first) {
+        const auto& str = *first;
+        std::copy(str.begin(), str.end(), symbols + pos);
+        pos += str.size();
+        ends[idx] = Offset(pos);
+    }
+}
+
+template <typename Offset, typename BatchOfStrings>
+void pack(const BatchOfStrings& strings, ov::Tensor& destination, string_offsets format, size_t symbols_size) {
+    const size_t batch_size = strings.size();
+    Offset* offsets = allocate<Offset>(destination, format, batch_size, symbols_size);
+    copy_strings(strings.begin(), batch_size, 0, offsets + 1, reinterpret_cast<char*>(offsets + batch_size + 1));
+}
+
+template <typename BatchOfStrings>
+void pack_strings(const BatchOfStrings& strings, ov::Tensor& destination, const string_offsets* requested) {
+    // The tensor is allocated at once, so the lengths are summed before the strings are copied. The pass reads
+    // the sizes only, the characters are touched once.
+    size_t symbols_size = 0;
+    for (const auto& str : strings)
+        symbols_size += str.size();
+
+    const string_offsets format = select_format(requested, symbols_size);
+    if (format == string_offsets::i32)
+        pack<int32_t>(strings, destination, format, symbols_size);
+    else
+        pack<int64_t>(strings, destination, format, symbols_size);
+}
+
+// Runs body(chunk) for every chunk in the thread pool of OpenVINO, so no threads are started per call
+template <typename Body>
+void run_chunks(size_t num_chunks, const Body& body) {
+    ov::parallel_for(num_chunks, [&body](size_t chunk) {
+        body(chunk);
+    });
+}
+
+// Copies the chunks of a batch concurrently, positions are the offsets of their symbols
+template <typename Offset, typename BatchOfStrings>
+void pack_chunks(const BatchOfStrings& strings,
+                 ov::Tensor& destination,
+                 string_offsets format,
+                 const std::vector<size_t>& bounds,
+                 const std::vector<size_t>& positions) {
+    const size_t batch_size = strings.size();
+    Offset* offsets = allocate<Offset>(destination, format, batch_size, positions.back());
+    char* symbols = reinterpret_cast<char*>(offsets + batch_size + 1);
+    run_chunks(bounds.size() - 1, [&](size_t chunk) {
+        copy_strings(std::next(strings.begin(), bounds[chunk]), bounds[chunk + 1] - bounds[chunk], positions[chunk],
+                     offsets + 1 + bounds[chunk], symbols);
+    });
+}
+
+template <typename BatchOfStrings>
+void pack_strings_parallel(const BatchOfStrings& strings,
+                           ov::Tensor& destination,
+                           const string_offsets* requested,
+                           size_t num_threads) {
+    // Fewer strings per chunk do not pay for handing it to another thread
+    constexpr size_t min_chunk = 4096;
+    const size_t batch_size = strings.size();
+    if (num_threads == 0)
+        num_threads = static_cast<size_t>(std::max(1, ov::parallel_get_max_threads()));
+    const size_t num_chunks = std::max(size_t(1), std::min(num_threads, batch_size / min_chunk));
+    if (num_chunks == 1)
+        return pack_strings(strings, destination, requested);
+
+    // Every chunk sums the lengths of its strings, the prefix sums of the chunks are the positions of their
+    // symbols, then every chunk copies its strings and writes its offsets independently of the others
+    std::vector<size_t> bounds(num_chunks + 1), positions(num_chunks + 1, 0);
+    for (size_t chunk = 0; chunk <= num_chunks; ++chunk)
+        bounds[chunk] = batch_size * chunk / num_chunks;
+    run_chunks(num_chunks, [&](size_t chunk) {
+        auto it = std::next(strings.begin(), bounds[chunk]);
+        size_t size = 0;
+        for (size_t idx = bounds[chunk]; idx < bounds[chunk + 1]; ++idx, ++it)
+            size += (*it).size();
+        positions[chunk + 1] = size;
+    });
+    std::partial_sum(positions.begin(), positions.end(), positions.begin());
+
+    const size_t symbols_size = positions[num_chunks];
+    const string_offsets format = select_format(requested, symbols_size);
+    if (format == string_offsets::i32)
+        pack_chunks<int32_t>(strings, destination, format, bounds, positions);
+    else
+        pack_chunks<int64_t>(strings, destination, format, bounds, positions);
+}
+
+}  // namespace strings_detail
+
 // Pack any container with string to ov::Tensor with element type u8
 // Requirements for BatchOfStrings: .size() with size and .begin(), .end() as iterators, elements with .begin(), .end() and .size()
 // so basically any STL container with std::string is compatible
 // Tensor destination will be reshaped according the input data
+// Offsets are 32-bit unless the strings take more than 2 GiB, pass the format explicitly to force one of them
 template <typename BatchOfStrings>
 void pack_strings(const BatchOfStrings& strings, ov::Tensor& destination) {
-    size_t batch_size = strings.size();
-
-    // First run over all elements: calculate total memory required to hold all strings
-    size_t symbols_size = std::accumulate(
-        strings.begin(), strings.end(), size_t(0),
-        [](size_t accum, typename BatchOfStrings::const_reference str)
-        { return accum + str.size(); });
-
-    size_t total_size = 4 * (1 + 1 + batch_size) + symbols_size;
-    destination.set_shape({total_size});
-
-    int32_t* pindices = reinterpret_cast<int32_t*>(destination.data<uint8_t>());
-    pindices[0] = int32_t(batch_size);
-    pindices[1] = 0;
-    pindices += 2;
-    char* psymbols = reinterpret_cast<char*>(pindices + batch_size);
-    size_t current_symbols_pos = 0;
-
-    for (const auto& str: strings) {
-        psymbols = std::copy(str.begin(), str.end(), psymbols);
-        current_symbols_pos += str.size();
-        *pindices = int32_t(current_symbols_pos);
-        ++pindices;
-    }
-}
-
-std::vector<std::string> unpack_strings(const ov::Tensor& source) {
-    size_t length = source.get_byte_size();
-    // check the format of the input bitstream representing the string tensor
-    OPENVINO_ASSERT(length >= 4, "Incorrect packed string tensor format: no batch size in the packed string tensor");
-    const int32_t* pindices = reinterpret_cast<const int32_t*>(source.data<const uint8_t>());
-    int32_t batch_size = pindices[0];
-    OPENVINO_ASSERT(int32_t(length) >= 4 + 4 + 4 * batch_size,
-        "Incorrect packed string tensor format: the packed string tensor must contain first string offset and end indices");
-    const int32_t* begin_ids = pindices + 1;
-    const int32_t* end_ids = pindices + 2;
-    const char* symbols = reinterpret_cast<const char*>(pindices + 2 + batch_size);
+    strings_detail::pack_strings(strings, destination, nullptr);
+}
+
+template <typename BatchOfStrings>
+void pack_strings(const BatchOfStrings& strings, ov::Tensor& destination, string_offsets format) {
+    strings_detail::pack_strings(strings, destination, &format);
+}
+
+// Same as pack_strings, with the batch split into num_threads chunks packed by the threads of OpenVINO
+// (ov::parallel_get_max_threads() chunks if it is 0). Small batches are packed on the calling thread. Iterators of BatchOfStrings should be random access,
+// every thread advances one to the beginning of its chunk.
+template <typename BatchOfStrings>
+void pack_strings_parallel(const BatchOfStrings& strings, ov::Tensor& destination, size_t num_threads = 0) {
+    strings_detail::pack_strings_parallel(strings, destination, nullptr, num_threads);
+}
+
+template <typename BatchOfStrings>
+void pack_strings_parallel(const BatchOfStrings& strings,
+                           ov::Tensor& destination,
+                           string_offsets format,
+                           size_t num_threads = 0) {
+    strings_detail::pack_strings_parallel(strings, destination, &format, num_threads);
+}
+
+namespace strings_detail {
+
+// Offsets and symbols of a packed tensor of either format
+struct packed_layout {
+    const void* offsets = nullptr;  // batch size + 1 offsets, the first one is the begin of the first string
+    const char* symbols = nullptr;
+    string_offsets format = string_offsets::i32;
+
+    template <typename Offset>
+    string_view get(size_t idx) const {
+        const Offset* ends = static_cast<const Offset*>(offsets);
+        return string_view(symbols + ends[idx], size_t(ends[idx + 1] - ends[idx]));
+    }
+    string_view operator[](size_t idx) const {
+        return format == string_offsets::i32 ? get<int32_t>(idx) : get<int64_t>(idx);
+    }
+};
+
+template <typename Offset>
+void check_offsets(const Offset* offsets, size_t batch_size, size_t symbols_size) {
+    Offset prev = 0;
+    for (size_t idx = 0; idx <= batch_size; ++idx) {
+        OPENVINO_ASSERT(offsets[idx] >= prev && uint64_t(offsets[idx]) <= symbols_size,
+            "Incorrect packed string tensor format: string offsets must be non-decreasing and within the tensor");
+        prev = offsets[idx];
+    }
+}
+
+}  // namespace strings_detail
+
+// Detects the format of a packed string tensor from its header
+inline string_offsets get_string_offsets(const ov::Tensor& source) {
+    OPENVINO_ASSERT(source.get_byte_size() >= 4,
+        "Incorrect packed string tensor format: no batch size in the packed string tensor");
+    const int32_t* words = reinterpret_cast<const int32_t*>(source.data<const uint8_t>());
+    return words[0] == strings_detail::wide_marker ? string_offsets::i64 : string_offsets::i32;
+}
+
+// Read-only random access range of the strings of a packed u8 tensor of either format, without copying them.
+// The view holds a reference to the tensor, so the memory of the strings lives as long as the view does,
+// but writing to the tensor or reshaping it invalidates the view like any other pointer to its data.
+class strings_view {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const string_view*;
+        using reference = string_view;
+
+        const_iterator() = default;
+        const_iterator(const strings_detail::packed_layout& layout, size_t idx) : m_layout(layout), m_idx(idx) {}
+
+        string_view operator*() const { return m_layout[m_idx]; }
+        string_view operator[](difference_type n) const { return m_layout[m_idx + n]; }
+
+        const_iterator& operator++() { ++m_idx; return *this; }
+        const_iterator operator++(int) { const_iterator tmp = *this; ++m_idx; return tmp; }
+        const_iterator& operator--() { --m_idx; return *this; }
+        const_iterator operator--(int) { const_iterator tmp = *this; --m_idx; return tmp; }
+        const_iterator& operator+=(difference_type n) { m_idx += n; return *this; }
+        const_iterator& operator-=(difference_type n) { m_idx -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(m_layout, m_idx + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(m_layout, m_idx - n); }
+        friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+        difference_type operator-(const const_iterator& other) const {
+            return difference_type(m_idx) - difference_type(other.m_idx);
+        }
+
+        bool operator==(const const_iterator& other) const { return m_idx == other.m_idx; }
+        bool operator!=(const const_iterator& other) const { return m_idx != other.m_idx; }
+        bool operator<(const const_iterator& other) const { return m_idx < other.m_idx; }
+        bool operator>(const const_iterator& other) const { return m_idx > other.m_idx; }
+        bool operator<=(const const_iterator& other) const { return m_idx <= other.m_idx; }
+        bool operator>=(const const_iterator& other) const { return m_idx >= other.m_idx; }
+
+    private:
+        strings_detail::packed_layout m_layout;
+        size_t m_idx = 0;
+    };
+    using iterator = const_iterator;
+    using value_type = string_view;
+    using size_type = size_t;
+
+    // Checks the format of the packed tensor once, so the accesses to the strings are not checked
+    explicit strings_view(const ov::Tensor& source) : m_tensor(source) {
+        const size_t length = source.get_byte_size();
+        const uint8_t* data = source.data<const uint8_t>();
+        m_layout.format = get_string_offsets(source);
+        size_t header;
+        if (m_layout.format == string_offsets::i32) {
+            const int32_t* words = reinterpret_cast<const int32_t*>(data);
+            OPENVINO_ASSERT(words[0] >= 0, "Incorrect packed string tensor format: negative batch size");
+            m_size = size_t(words[0]);
+            OPENVINO_ASSERT(length >= 4 + 4 && (length - 4 - 4) / 4 >= m_size,
+                "Incorrect packed string tensor format: the packed string tensor must contain first string offset and end indices");
+            m_layout.offsets = words + 1;
+            header = 4 * (1 + 1 + m_size);
+        } else {
+            OPENVINO_ASSERT(length >= 4 + 4 + 8 + 8,
+                "Incorrect packed string tensor format: no batch size in the packed string tensor");
+            const int32_t* words = reinterpret_cast<const int32_t*>(data);
+            OPENVINO_ASSERT(words[1] == strings_detail::wide_bits,
+                "Incorrect packed string tensor format: unsupported offset width ", words[1]);
+            const int64_t* wide = reinterpret_cast<const int64_t*>(data + 8);
+            OPENVINO_ASSERT(wide[0] >= 0, "Incorrect packed string tensor format: negative batch size");
+            OPENVINO_ASSERT(uint64_t(wide[0]) <= (length - 8 - 8 - 8) / 8,
+                "Incorrect packed string tensor format: the packed string tensor must contain first string offset and end indices");
+            m_size = size_t(wide[0]);
+            m_layout.offsets = wide + 1;
+            header = 8 * (1 + 1 + 1 + m_size);
+        }
+        m_layout.symbols = reinterpret_cast<const char*>(data + header);
+
+        if (m_layout.format == string_offsets::i32)
+            strings_detail::check_offsets(static_cast<const int32_t*>(m_layout.offsets), m_size, length - header);
+        else
+            strings_detail::check_offsets(static_cast<const int64_t*>(m_layout.offsets), m_size, length - header);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    string_offsets format() const { return m_layout.format; }
+
+    string_view operator[](size_t idx) const { return m_layout[idx]; }
+    string_view at(size_t idx) const {
+        OPENVINO_ASSERT(idx < m_size, "String index ", idx, " is out of range for a batch of ", m_size, " strings");
+        return m_layout[idx];
+    }
+
+    // Iterators point to the tensor, not to the view, so they stay valid while any copy of the view exists
+    const_iterator begin() const { return const_iterator(m_layout, 0); }
+    const_iterator end() const { return const_iterator(m_layout, m_size); }
+
+    // Packed tensor the strings point to
+    const ov::Tensor& get_tensor() const { return m_tensor; }
+
+private:
+    ov::Tensor m_tensor;
+    size_t m_size = 0;
+    strings_detail::packed_layout m_layout;
+};
+
+// Views the strings of a packed tensor in place, one view per element instead of one allocation per element
+inline strings_view unpack_strings_view(const ov::Tensor& source) {
+    return strings_view(source);
+}
 
+// Copies the strings of a packed tensor. Prefer unpack_strings_view when the strings are only read.
+inline std::vector<std::string> unpack_strings(const ov::Tensor& source) {
+    const strings_view strings(source);
     std::vector<std::string> result;
-    result.reserve(size_t(batch_size));
-    for (int32_t idx = 0; idx < batch_size; ++idx) {
-        result.emplace_back(symbols + begin_ids[idx], symbols + end_ids[idx]);
+    result.reserve(strings.size());
+    for (const auto str : strings) {
+        result.emplace_back(str.data(), str.size());
     }
     return result;
 }
@@ -5,6 +5,7 @@
 #include <openvino/core/extension.hpp>
 #include <openvino/core/op_extension.hpp>
 #include <openvino/frontend/extension.hpp>
+#include <openvino/frontend/extension/decoder_transformation.hpp>
 #include <openvino/frontend/node_context.hpp>
 
 #ifdef calculate_grid
@@ -26,37 +27,80 @@
 #endif
 
 #ifdef fft
-#    include "fft.hpp"
+#    include "fft/fft.hpp"
+#    include "fft/spectral_filter.hpp"
 #    define FFT_EXT                                                                                    \
             std::make_shared<ov::OpExtension<TemplateExtension::FFT>>(),                               \
-            std::make_shared<ov::frontend::OpExtension<TemplateExtension::FFT>>(),
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::FFT>>(),                     \
+            std::make_shared<ov::OpExtension<TemplateExtension::RFFT>>(),                              \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::RFFT>>(),                    \
+            std::make_shared<ov::OpExtension<TemplateExtension::IRFFT>>(),                             \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::IRFFT>>(),                   \
+            std::make_shared<ov::OpExtension<TemplateExtension::SpectralFilter>>(),
 #else
 #    define FFT_EXT
 #endif
 
-#ifdef sparse_conv_transpose
-#    include "sparse_conv_transpose.hpp"
-#    define S_CONV_TRANSPOSE_EXT                                                                      \
-            std::make_shared<ov::OpExtension<TemplateExtension::SparseConvTranspose>>(),              \
-            std::make_shared<ov::frontend::OpExtension<TemplateExtension::SparseConvTranspose>>(),
+// Fuses FFT -> ComplexMultiplication -> inverse FFT of the converted models into SpectralFilter
+#if defined(fft) && defined(complex_mul)
+#    include "fft/spectral_filter_fusion.hpp"
+#    define SPECTRAL_FILTER_FUSION_EXT                                                                 \
+            std::make_shared<ov::frontend::DecoderTransformationExtension>(                            \
+                TemplateExtension::SpectralFilterFusion()),
 #else
-#    define S_CONV_TRANSPOSE_EXT
+#    define SPECTRAL_FILTER_FUSION_EXT
+#endif
+
+#ifdef grid_sample
+#    include "grid_sample.hpp"
+#    define GRID_SAMPLE_EXT                                                                            \
+            std::make_shared<ov::OpExtension<TemplateExtension::GridSample>>(),                        \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::GridSample>>(),
+#else
+#    define GRID_SAMPLE_EXT
 #endif
 
 #ifdef sparse_conv
-#    include "sparse_conv.hpp"
+#    include "sparse_conv/sparse_conv.hpp"
+#    include "sparse_conv/sparse_conv_transpose.hpp"
 #    define S_CONV_EXT                                                                                \
             std::make_shared<ov::OpExtension<TemplateExtension::SparseConv>>(),                       \
-            std::make_shared<ov::frontend::OpExtension<TemplateExtension::SparseConv>>(),
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::SparseConv>>(),             \
+            std::make_shared<ov::OpExtension<TemplateExtension::SparseConvTranspose>>(),              \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::SparseConvTranspose>>(),
 #else
 #    define S_CONV_EXT
 #endif
 
+#ifdef tokenizer
+#    include "tokenizer/tokenizer.hpp"
+#    define TOKENIZER_EXT                                                                              \
+            std::make_shared<ov::OpExtension<TemplateExtension::Tokenizer>>(),                         \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::Tokenizer>>(),
+#else
+#    define TOKENIZER_EXT
+#endif
+
+#ifdef token_merging
+#    include "token_merging/tome_merge.hpp"
+#    include "token_merging/tome_unmerge.hpp"
+#    define TOKEN_MERGING_EXT                                                                          \
+            std::make_shared<ov::OpExtension<TemplateExtension::ToMeMerge>>(),                         \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::ToMeMerge>>(),               \
+            std::make_shared<ov::OpExtension<TemplateExtension::ToMeUnmerge>>(),                       \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::ToMeUnmerge>>(),
+#else
+#    define TOKEN_MERGING_EXT
+#endif
+
 OPENVINO_CREATE_EXTENSIONS(std::vector<ov::Extension::Ptr>(
     {
         CALCULATE_GRID_EXT
         FFT_EXT
-        S_CONV_TRANSPOSE_EXT
+        GRID_SAMPLE_EXT
         S_CONV_EXT
         COMPLEX_MUL_EXT
+        SPECTRAL_FILTER_FUSION_EXT
+        TOKENIZER_EXT
+        TOKEN_MERGING_EXT
     }));
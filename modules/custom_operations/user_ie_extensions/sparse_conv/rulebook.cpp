@@ -0,0 +1,383 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "rulebook.hpp"
+#include "voxel_grid.hpp"
+#include "../cpu_isa.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include <openvino/core/except.hpp>
+#include <openvino/core/parallel.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Output points of a rulebook block. Pairs of a block-offset group are gathered and multiplied together,
+// so the block is large enough to give the GEMM a few dozens of rows per offset.
+constexpr size_t block_size = 256;
+
+// Register tile of the GEMM: 4 rows by 16 columns of the output
+constexpr size_t tile_rows = 4;
+constexpr size_t tile_cols = 16;
+
+struct Pair {
+    uint32_t offset;
+    uint32_t input;
+    uint32_t output;
+};
+
+// out[rows[r]] += A[r] * B for a tile of tile_rows rows of A (tile_rows x IC) and a column panel of B
+// (IC x tile_cols). The accumulators stay in registers; only numRows x numCols of them are stored.
+CPU_ISA_INLINE void gemm_tile(const float* A,
+               const float* B,
+               const uint32_t* rows,
+               size_t numRows,
+               size_t numCols,
+               size_t IC,
+               size_t OC,
+               float* out) {
+    // Rows are unrolled by hand, so the compiler vectorizes the columns only
+    static_assert(tile_rows == 4, "GEMM tile is unrolled for 4 rows");
+    float acc[tile_rows][tile_cols] = {};
+    for (size_t ic = 0; ic < IC; ++ic) {
+        const float* b = B + ic * tile_cols;
+        const float a0 = A[ic];
+        const float a1 = A[IC + ic];
+        const float a2 = A[2 * IC + ic];
+        const float a3 = A[3 * IC + ic];
+        for (size_t c = 0; c < tile_cols; ++c) {
+            acc[0][c] += a0 * b[c];
+            acc[1][c] += a1 * b[c];
+            acc[2][c] += a2 * b[c];
+            acc[3][c] += a3 * b[c];
+        }
+    }
+    for (size_t r = 0; r < numRows; ++r) {
+        float* dst = out + rows[r] * OC;
+        for (size_t c = 0; c < numCols; ++c)
+            dst[c] += acc[r][c];
+    }
+}
+
+// out[rows[r]] += panel[r] * slice for the gathered rows of an offset and every column panel of its kernel slice
+CPU_ISA_INLINE void gemm_offset(const float* panel,
+                                const float* slice,
+                                const uint32_t* rows,
+                                size_t numRows,
+                                size_t IC,
+                                size_t OC,
+                                float* out) {
+    for (size_t t = 0; t * tile_cols < OC; ++t) {
+        const size_t numCols = std::min(tile_cols, OC - t * tile_cols);
+        for (size_t r = 0; r < numRows; r += tile_rows)
+            gemm_tile(panel + r * IC, slice + t * IC * tile_cols, rows + r, std::min(tile_rows, numRows - r), numCols,
+                      IC, OC, out + t * tile_cols);
+    }
+}
+
+// The tile is written in plain C++, each instruction set gets its own copy vectorized by the compiler:
+// a 16-column row of accumulators is a single register with AVX-512, two with AVX2 and four with SSE.
+#ifdef CPU_ISA_X86
+CPU_ISA_TARGET_AVX512 void gemm_offset_avx512(const float* panel,
+                                              const float* slice,
+                                              const uint32_t* rows,
+                                              size_t numRows,
+                                              size_t IC,
+                                              size_t OC,
+                                              float* out) {
+    gemm_offset(panel, slice, rows, numRows, IC, OC, out);
+}
+
+CPU_ISA_TARGET_AVX2 void gemm_offset_avx2(const float* panel,
+                                          const float* slice,
+                                          const uint32_t* rows,
+                                          size_t numRows,
+                                          size_t IC,
+                                          size_t OC,
+                                          float* out) {
+    gemm_offset(panel, slice, rows, numRows, IC, OC, out);
+}
+
+CPU_ISA_TARGET_SSE42 void gemm_offset_sse42(const float* panel,
+                                            const float* slice,
+                                            const uint32_t* rows,
+                                            size_t numRows,
+                                            size_t IC,
+                                            size_t OC,
+                                            float* out) {
+    gemm_offset(panel, slice, rows, numRows, IC, OC, out);
+}
+#endif
+
+void gemm_offset_baseline(const float* panel,
+                          const float* slice,
+                          const uint32_t* rows,
+                          size_t numRows,
+                          size_t IC,
+                          size_t OC,
+                          float* out) {
+    gemm_offset(panel, slice, rows, numRows, IC, OC, out);
+}
+
+using GemmKernel = void (*)(const float*, const float*, const uint32_t*, size_t, size_t, size_t, float*);
+
+GemmKernel select_gemm_kernel() {
+    switch (get_cpu_isa()) {
+#ifdef CPU_ISA_X86
+    case CpuIsa::avx512:
+        return gemm_offset_avx512;
+    case CpuIsa::avx2:
+        return gemm_offset_avx2;
+    case CpuIsa::sse42:
+        return gemm_offset_sse42;
+#endif
+    default:
+        return gemm_offset_baseline;
+    }
+}
+
+// Chosen when the extension is loaded
+const GemmKernel gemm_kernel = select_gemm_kernel();
+
+// Hash of the bit patterns of the floats
+uint64_t fingerprint(const float* data, size_t size, uint64_t seed) {
+    uint64_t hash = seed ^ (size * 0x9E3779B97F4A7C15ull);
+    for (size_t i = 0; i < size; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, data + i, sizeof(bits));
+        hash = (hash ^ bits) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+struct CachedRulebook {
+    std::vector<float> inpPos;
+    std::vector<float> outPos;
+    std::vector<float> offset;
+    std::shared_ptr<const Rulebook> rules;
+
+    bool matches(const float* inp, size_t numInp, const float* out, size_t numOut, const float* off) const {
+        // Bitwise, like the fingerprint
+        return inpPos.size() == numInp * 3 && outPos.size() == numOut * 3 &&
+               std::memcmp(inpPos.data(), inp, inpPos.size() * sizeof(float)) == 0 &&
+               std::memcmp(outPos.data(), out, outPos.size() * sizeof(float)) == 0 &&
+               std::memcmp(offset.data(), off, offset.size() * sizeof(float)) == 0;
+    }
+};
+
+}  // namespace
+
+Rulebook TemplateExtension::build_rulebook(const float* inpPos,
+                                           size_t numInpPoints,
+                                           const float* outPos,
+                                           size_t numOutPoints,
+                                           const float* offset,
+                                           int kd,
+                                           int kh,
+                                           int kw,
+                                           bool transpose) {
+    OPENVINO_ASSERT(numInpPoints <= std::numeric_limits<uint32_t>::max() &&
+                    numOutPoints <= std::numeric_limits<uint32_t>::max(),
+                    "Too many points for a sparse convolution");
+
+    Rulebook rules;
+    rules.block = block_size;
+    rules.numOffsets = static_cast<size_t>(kd) * kh * kw;
+    const size_t numBlocks = (numOutPoints + block_size - 1) / block_size;
+    rules.ranges.assign(numBlocks * rules.numOffsets + 1, 0);
+
+    // See https://github.com/isl-org/Open3D/blob/master/python/open3d/ml/torch/python/layers/convolutions.py
+    float rw = kw * 0.51f;
+    float rh = kh * 0.51f;
+    float rd = kd * 0.51f;
+
+    // Every output point probes only the grid cells overlapped by its kernel box
+    const VoxelGrid grid(inpPos, numInpPoints);
+
+    std::vector<std::vector<Pair>> blocks(numBlocks);
+    ov::parallel_for(numBlocks, [&](size_t b) {
+        std::vector<Pair> pairs;
+        size_t* counts = rules.ranges.data() + b * rules.numOffsets + 1;
+        const size_t end = std::min(numOutPoints, (b + 1) * block_size);
+        for (size_t i = b * block_size; i < end; ++i) {
+            const float xi = outPos[i * 3] - offset[0];
+            const float yi = outPos[i * 3 + 1] - offset[1];
+            const float zi = outPos[i * 3 + 2] - offset[2];
+            const float lo[] = {xi - rw, yi - rh, zi - rd};
+            const float hi[] = {xi + rw, yi + rh, zi + rd};
+
+            grid.for_each_candidate(lo, hi, [&](size_t j) {
+                const float xj = inpPos[j * 3];
+                const float yj = inpPos[j * 3 + 1];
+                const float zj = inpPos[j * 3 + 2];
+
+                if (xi - rw <= xj && xj <= xi + rw &&
+                    yi - rh <= yj && yj <= yi + rh &&
+                    zi - rd <= zj && zj <= zi + rd) {
+
+                    int w = std::min(static_cast<int>(xj - xi + kw * 0.5f), kw - 1);
+                    int h = std::min(static_cast<int>(yj - yi + kh * 0.5f), kh - 1);
+                    int d = std::min(static_cast<int>(zj - zi + kd * 0.5f), kd - 1);
+                    if (transpose) {
+                        w = kw - 1 - w;
+                        h = kh - 1 - h;
+                        d = kd - 1 - d;
+                    }
+
+                    const uint32_t k = static_cast<uint32_t>(w + kw * (h + kh * d));
+                    pairs.push_back({k, static_cast<uint32_t>(j), static_cast<uint32_t>(i)});
+                    counts[k] += 1;
+                }
+            });
+        }
+
+        // Counting sort by kernel offset keeps the output order inside every offset
+        std::vector<size_t> starts(rules.numOffsets, 0);
+        for (size_t k = 1; k < rules.numOffsets; ++k)
+            starts[k] = starts[k - 1] + counts[k - 1];
+        blocks[b].resize(pairs.size());
+        for (const Pair& pair : pairs)
+            blocks[b][starts[pair.offset]++] = pair;
+    });
+
+    for (size_t i = 1; i < rules.ranges.size(); ++i)
+        rules.ranges[i] += rules.ranges[i - 1];
+
+    rules.inputs.resize(rules.ranges.back());
+    rules.outputs.resize(rules.ranges.back());
+    ov::parallel_for(numBlocks, [&](size_t b) {
+        const size_t begin = rules.ranges[b * rules.numOffsets];
+        for (size_t p = 0; p < blocks[b].size(); ++p) {
+            rules.inputs[begin + p] = blocks[b][p].input;
+            rules.outputs[begin + p] = blocks[b][p].output;
+        }
+    });
+    return rules;
+}
+
+std::shared_ptr<const Rulebook> TemplateExtension::get_rulebook(const float* inpPos,
+                                                                size_t numInpPoints,
+                                                                const float* outPos,
+                                                                size_t numOutPoints,
+                                                                const float* offset,
+                                                                int kd,
+                                                                int kh,
+                                                                int kw,
+                                                                bool transpose) {
+    // Rulebooks of large clouds take megabytes, so the cache is bounded by the number of entries. The least
+    // recently used rulebook is evicted when it is full, rulebooks in use stay alive through their owners.
+    static const size_t capacity = 16;
+    using Key = std::tuple<uint64_t, int, int, int, bool>;
+    struct Entry {
+        CachedRulebook rulebook;
+        std::list<Key>::iterator use;
+    };
+    static std::mutex mutex;
+    static std::list<Key> uses;  // most recently used first
+    static std::map<Key, Entry> cache;
+
+    uint64_t hash = fingerprint(inpPos, numInpPoints * 3, 0);
+    hash = fingerprint(outPos, numOutPoints * 3, hash);
+    hash = fingerprint(offset, 3, hash);
+    const Key key = std::make_tuple(hash, kd, kh, kw, transpose);
+    // Returns the cached rulebook of the same points and marks it as the most recently used one, the mutex has
+    // to be locked
+    auto find = [&]() -> std::shared_ptr<const Rulebook> {
+        auto it = cache.find(key);
+        if (it == cache.end() || !it->second.rulebook.matches(inpPos, numInpPoints, outPos, numOutPoints, offset))
+            return nullptr;
+        uses.splice(uses.begin(), uses, it->second.use);
+        return it->second.rulebook.rules;
+    };
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto rules = find())
+            return rules;
+    }
+
+    // Built without the lock: matching is parallel and must not block other threads which look up the cache
+    CachedRulebook entry;
+    entry.inpPos.assign(inpPos, inpPos + numInpPoints * 3);
+    entry.outPos.assign(outPos, outPos + numOutPoints * 3);
+    entry.offset.assign(offset, offset + 3);
+    entry.rules = std::make_shared<const Rulebook>(
+        build_rulebook(inpPos, numInpPoints, outPos, numOutPoints, offset, kd, kh, kw, transpose));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another thread may have built the same rulebook meanwhile, all the callers share the cached one
+    if (auto cached = find())
+        return cached;
+    auto rules = entry.rules;
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        // Same fingerprint of other points, the new rulebook replaces the cached one
+        it->second.rulebook = std::move(entry);
+        uses.splice(uses.begin(), uses, it->second.use);
+        return rules;
+    }
+    if (cache.size() >= capacity) {
+        cache.erase(uses.back());
+        uses.pop_back();
+    }
+    uses.push_front(key);
+    cache.emplace(key, Entry{std::move(entry), uses.begin()});
+    return rules;
+}
+
+void TemplateExtension::pack_kernel(const float* kernel,
+                                    size_t numOffsets,
+                                    size_t IC,
+                                    size_t OC,
+                                    std::vector<float>& packed) {
+    // Kernel layout is DxHxWxICxOC, so the slice of an offset is a dense IC x OC matrix. Slices are split
+    // into column panels of tile_cols, the last one padded with zeros, so every GEMM tile has the full width.
+    const size_t numPanels = (OC + tile_cols - 1) / tile_cols;
+    const size_t sliceSize = numPanels * IC * tile_cols;
+    packed.assign(numOffsets * sliceSize, 0.0f);
+    ov::parallel_for(numOffsets, [&](size_t k) {
+        for (size_t ic = 0; ic < IC; ++ic) {
+            const float* src = kernel + (k * IC + ic) * OC;
+            for (size_t oc = 0; oc < OC; ++oc)
+                packed[k * sliceSize + ((oc / tile_cols) * IC + ic) * tile_cols + oc % tile_cols] = src[oc];
+        }
+    });
+}
+
+void TemplateExtension::run_rulebook(const Rulebook& rules,
+                                     const float* features,
+                                     const float* packedKernel,
+                                     float* out,
+                                     size_t IC,
+                                     size_t OC) {
+    const size_t sliceSize = (OC + tile_cols - 1) / tile_cols * IC * tile_cols;
+    const size_t numBlocks = (rules.ranges.size() - 1) / rules.numOffsets;
+    ov::parallel_for(numBlocks, [&](size_t b) {
+        static thread_local std::vector<float> panel;
+        for (size_t k = 0; k < rules.numOffsets; ++k) {
+            const size_t begin = rules.ranges[b * rules.numOffsets + k];
+            const size_t end = rules.ranges[b * rules.numOffsets + k + 1];
+            if (begin == end)
+                continue;
+
+            // Gathered features, padded with zero rows to whole tiles
+            const size_t numRows = end - begin;
+            panel.assign((numRows + tile_rows - 1) / tile_rows * tile_rows * IC, 0.0f);
+            for (size_t p = begin; p < end; ++p)
+                std::copy_n(features + rules.inputs[p] * IC, IC, panel.data() + (p - begin) * IC);
+
+            gemm_kernel(panel.data(), packedKernel + k * sliceSize, rules.outputs.data() + begin, numRows, IC, OC,
+                        out);
+        }
+    });
+}
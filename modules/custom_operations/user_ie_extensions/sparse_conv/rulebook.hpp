@@ -0,0 +1,66 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TemplateExtension {
+
+// Kernel map of a sparse convolution: the (input, output) point pairs connected by every kernel offset.
+// Output points are split into blocks of `block` points. Pairs are grouped by block, then by kernel offset,
+// and follow the output order inside a group, so every block can be computed independently.
+struct Rulebook {
+    size_t block;
+    size_t numOffsets;             // kd * kh * kw
+    std::vector<uint32_t> inputs;  // input point of every pair
+    std::vector<uint32_t> outputs;
+    std::vector<size_t> ranges;    // pairs of block b and offset k are [ranges[b * numOffsets + k], ranges[b * numOffsets + k + 1])
+};
+
+// Matches input and output points the way Open3D does: an input point contributes to an output point
+// through the kernel cell it falls into when the kernel is centered at the output point shifted by `offset`.
+// Transposed convolutions use the mirrored kernel cell.
+Rulebook build_rulebook(const float* inpPos,
+                        size_t numInpPoints,
+                        const float* outPos,
+                        size_t numOutPoints,
+                        const float* offset,
+                        int kd,
+                        int kh,
+                        int kw,
+                        bool transpose);
+
+// Returns the rulebook of build_rulebook() for the given arguments. Consecutive layers of a network often
+// share point clouds and kernel sizes, so rulebooks are cached by a fingerprint of the positions, kernel
+// extents and offset. Cached positions are compared on every hit, so a fingerprint collision only costs a rebuild.
+std::shared_ptr<const Rulebook> get_rulebook(const float* inpPos,
+                                             size_t numInpPoints,
+                                             const float* outPos,
+                                             size_t numOutPoints,
+                                             const float* offset,
+                                             int kd,
+                                             int kh,
+                                             int kw,
+                                             bool transpose);
+
+// Lays out a DxHxWxICxOC kernel for run_rulebook: the IC x OC slice of every offset is split into column panels
+// of the GEMM tile width. Constant kernels are packed once per node and reused by all the inferences.
+void pack_kernel(const float* kernel, size_t numOffsets, size_t IC, size_t OC, std::vector<float>& packed);
+
+// out[o] += features[i] * kernel[k] for every pair (i, o) of the offset k. Pairs of an offset are gathered
+// into a dense matrix which is multiplied by the IC x OC kernel slice and the products are added to the output
+// rows. Every output row is updated by a single thread in the rulebook order, so results are deterministic.
+// The kernel is packed by pack_kernel().
+void run_rulebook(const Rulebook& rules,
+                  const float* features,
+                  const float* packedKernel,
+                  float* out,
+                  size_t IC,
+                  size_t OC);
+
+}  // namespace TemplateExtension
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <vector>
+
 #include <openvino/op/op.hpp>
 
 namespace TemplateExtension {
@@ -19,6 +22,13 @@ public:
 
     bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
     bool has_evaluate() const override;
+
+private:
+    const float* get_packed_kernel(const ov::TensorVector& inputs) const;
+
+    // Packed constant kernel, built by the first inference of the node
+    mutable std::once_flag kernelOnce;
+    mutable std::vector<float> constKernel;
 };
 
 }  // namespace TemplateExtension
@@ -3,6 +3,9 @@
 //
 
 #include "sparse_conv_transpose.hpp"
+#include "rulebook.hpp"
+
+#include <openvino/op/constant.hpp>
 
 using namespace TemplateExtension;
 
@@ -26,7 +29,6 @@ bool SparseConvTranspose::evaluate(ov::TensorVector& outputs, const ov::TensorVe
     const float* features = reinterpret_cast<float*>(inputs[0].data());
     const float* inpPos = reinterpret_cast<float*>(inputs[1].data());
     const float* outPos = reinterpret_cast<float*>(inputs[2].data());
-    const float* kernel = reinterpret_cast<float*>(inputs[3].data());
     const float* offset = reinterpret_cast<float*>(inputs[4].data());
     float* out = reinterpret_cast<float*>(outputs[0].data());
     memset(out, 0, outputs[0].get_byte_size());
@@ -42,11 +44,6 @@ bool SparseConvTranspose::evaluate(ov::TensorVector& outputs, const ov::TensorVe
     const int IC = static_cast<int>(kernelDims[3]);
     const int OC = static_cast<int>(kernelDims[4]);
 
-    // See https://github.com/isl-org/Open3D/blob/master/python/open3d/ml/torch/python/layers/convolutions.py
-    float rw = kw * 0.51f;
-    float rh = kh * 0.51f;
-    float rd = kd * 0.51f;
-
     for (size_t i = 0; i < numInpPoints; ++i) {
         if (inpPos[i * 3] < 0) {
             numInpPoints = i;
@@ -54,36 +51,27 @@ bool SparseConvTranspose::evaluate(ov::TensorVector& outputs, const ov::TensorVe
         }
     }
 
-    for (size_t i = 0; i < numOutPoints; ++i) {
-        const float xi = outPos[i * 3] - offset[0];
-        const float yi = outPos[i * 3 + 1] - offset[1];
-        const float zi = outPos[i * 3 + 2] - offset[2];
-
-        // Accumulate features which inside the kernel
-        for (size_t j = 0; j < numInpPoints; ++j) {
-            const float xj = inpPos[j * 3];
-            const float yj = inpPos[j * 3 + 1];
-            const float zj = inpPos[j * 3 + 2];
-
-            if (xi - rw <= xj && xj <= xi + rw &&
-                yi - rh <= yj && yj <= yi + rh &&
-                zi - rd <= zj && zj <= zi + rd) {
-
-                const int w = kw - 1 - std::min(static_cast<int>(xj - xi + kw * 0.5f), kw - 1);
-                const int h = kh - 1 - std::min(static_cast<int>(yj - yi + kh * 0.5f), kh - 1);
-                const int d = kd - 1 - std::min(static_cast<int>(zj - zi + kd * 0.5f), kd - 1);
+    // Neighbour pairs are grouped by kernel offset, so each offset is a single GEMM over its pairs.
+    // Layers which share the point clouds reuse the rulebook built by the first of them.
+    const auto rules = get_rulebook(inpPos, numInpPoints, outPos, numOutPoints, offset, kd, kh, kw, true);
+    run_rulebook(*rules, features, get_packed_kernel(inputs), out, IC, OC);
+    return true;
+}
 
-                const float* featuresOffset = features + j * IC;
-                for (int ic = 0; ic < IC; ++ic) {
-                    const float* kernelOffset = kernel + OC * (ic + IC * (w + kw * (h + kh * d)));
-                    for (int oc = 0; oc < OC; ++oc) {
-                        out[i * OC + oc] += kernelOffset[oc] * featuresOffset[ic];
-                    }
-                }
-            }
-        }
+const float* SparseConvTranspose::get_packed_kernel(const ov::TensorVector& inputs) const {
+    const float* kernel = reinterpret_cast<float*>(inputs[3].data());
+    const ov::Shape& kernelDims = inputs[3].get_shape();
+    const size_t numOffsets = kernelDims[0] * kernelDims[1] * kernelDims[2];
+    // Weights of a model are constants, so they are packed once and shared by all the inferences
+    if (!ov::as_type_ptr<ov::op::v0::Constant>(input_value(3).get_node_shared_ptr())) {
+        static thread_local std::vector<float> packed;
+        pack_kernel(kernel, numOffsets, kernelDims[3], kernelDims[4], packed);
+        return packed.data();
     }
-    return true;
+    std::call_once(kernelOnce, [&]() {
+        pack_kernel(kernel, numOffsets, kernelDims[3], kernelDims[4], constKernel);
+    });
+    return constKernel.data();
 }
 
 bool SparseConvTranspose::has_evaluate() const {
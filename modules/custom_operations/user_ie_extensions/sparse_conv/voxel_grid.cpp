@@ -0,0 +1,45 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "voxel_grid.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace TemplateExtension;
+
+VoxelGrid::VoxelGrid(const float* positions, size_t count) {
+    // Sorting by cell key groups the points of every cell, ties keep the index order
+    std::vector<std::pair<uint64_t, uint32_t>> keyed(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float* p = positions + i * 3;
+        keyed[i] = std::make_pair(pack(cell(p[0]), cell(p[1]), cell(p[2])), static_cast<uint32_t>(i));
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    points.resize(count);
+    size_t numCells = 0;
+    for (size_t i = 0; i < count; ++i) {
+        points[i] = keyed[i].second;
+        numCells += i == 0 || keyed[i].first != keyed[i - 1].first;
+    }
+
+    // Load factor stays below 1/2, so probe sequences are short
+    size_t capacity = 16;
+    while (capacity < 2 * numCells)
+        capacity *= 2;
+    mask = capacity - 1;
+    slots.assign(capacity, Slot{empty_key, 0, 0});
+
+    for (size_t begin = 0; begin < count;) {
+        size_t end = begin + 1;
+        while (end < count && keyed[end].first == keyed[begin].first)
+            ++end;
+        size_t i = bucket(keyed[begin].first);
+        while (slots[i].key != empty_key)
+            i = (i + 1) & mask;
+        slots[i] = Slot{keyed[begin].first, static_cast<uint32_t>(begin), static_cast<uint32_t>(end)};
+        begin = end;
+    }
+}
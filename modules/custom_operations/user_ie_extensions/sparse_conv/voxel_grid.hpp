@@ -0,0 +1,87 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace TemplateExtension {
+
+// Hash grid of points bucketed into unit voxels. Cells are stored in an open addressing table keyed by
+// packed integer coordinates and the points of every cell are contiguous, so a box query touches only
+// the cells it overlaps instead of every point of the cloud.
+class VoxelGrid {
+public:
+    // Positions are `count` (x, y, z) triplets given in voxels
+    VoxelGrid(const float* positions, size_t count);
+
+    // Calls visit(j) for every point j whose cell overlaps the box [lo, hi]. Points of the same cell are
+    // visited in ascending order. Candidates may lie outside of the box, so the caller applies its own test.
+    template <typename Visit>
+    void for_each_candidate(const float* lo, const float* hi, const Visit& visit) const {
+        const int x0 = cell(lo[0]), x1 = cell(hi[0]);
+        const int y0 = cell(lo[1]), y1 = cell(hi[1]);
+        const int z0 = cell(lo[2]), z1 = cell(hi[2]);
+        for (int z = z0; z <= z1; ++z) {
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    const Slot* slot = find(pack(x, y, z));
+                    if (!slot)
+                        continue;
+                    for (uint32_t k = slot->begin; k < slot->end; ++k)
+                        visit(static_cast<size_t>(points[k]));
+                }
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key;
+        uint32_t begin;  // range of the cell points in `points`
+        uint32_t end;
+    };
+
+    // 21 bits per coordinate. Farther points are clamped to the border cells, which keeps queries exact.
+    static constexpr int cell_bits = 21;
+    static constexpr int cell_bias = 1 << (cell_bits - 1);
+    static constexpr uint64_t empty_key = ~uint64_t(0);
+
+    static int cell(float v) {
+        const float c = std::floor(v);
+        if (!(c >= -cell_bias))  // NaN goes to the border as well
+            return -cell_bias;
+        if (c > cell_bias - 1)
+            return cell_bias - 1;
+        return static_cast<int>(c);
+    }
+
+    static uint64_t pack(int x, int y, int z) {
+        return (static_cast<uint64_t>(z + cell_bias) << (2 * cell_bits)) |
+               (static_cast<uint64_t>(y + cell_bias) << cell_bits) | static_cast<uint64_t>(x + cell_bias);
+    }
+
+    size_t bucket(uint64_t key) const {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    }
+
+    const Slot* find(uint64_t key) const {
+        for (size_t i = bucket(key);; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.key == key)
+                return &slot;
+            if (slot.key == empty_key)
+                return nullptr;
+        }
+    }
+
+    std::vector<uint32_t> points;  // point indices grouped by cell
+    std::vector<Slot> slots;
+    size_t mask;
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,220 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "tome_merge.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <openvino/core/parallel.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Eight partial sums, so the products are vectorized without reassociating a single sum
+float dot(const float* a, const float* b, size_t size) {
+    float acc[8] = {};
+    size_t c = 0;
+    for (; c + 8 <= size; c += 8)
+        for (size_t k = 0; k < 8; ++k)
+            acc[k] += a[c + k] * b[c + k];
+    for (; c < size; ++c)
+        acc[0] += a[c] * b[c];
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+}  // namespace
+
+ToMeMerge::ToMeMerge(const ov::OutputVector& args, int64_t r, bool class_token, bool distill_token)
+    : Op(args),
+      r(r),
+      class_token(class_token),
+      distill_token(distill_token) {
+    constructor_validate_and_infer_types();
+}
+
+int64_t ToMeMerge::get_merged(int64_t numTokens) const {
+    const int64_t protectedTokens = (class_token ? 1 : 0) + (distill_token ? 1 : 0);
+    return std::max<int64_t>(0, std::min(r, (numTokens - protectedTokens) / 2));
+}
+
+void ToMeMerge::validate_and_infer_types() {
+    OPENVINO_ASSERT(get_input_size() == 2 || get_input_size() == 3, "ToMeMerge takes tokens, metric and sizes");
+    const auto& shape = get_input_partial_shape(0);
+    OPENVINO_ASSERT(shape.rank().compatible(3), "ToMeMerge tokens must have a shape [batch, tokens, channels]");
+    OPENVINO_ASSERT(get_input_partial_shape(1).rank().compatible(3),
+                    "ToMeMerge metric must have a shape [batch, tokens, channels]");
+
+    auto outShape = shape;
+    if (shape.rank().is_static() && shape[1].is_static())
+        outShape[1] = shape[1].get_length() - get_merged(shape[1].get_length());
+    else if (shape.rank().is_static())
+        outShape[1] = ov::Dimension::dynamic();
+    set_output_type(0, get_input_element_type(0), outShape);
+
+    auto sizeShape = outShape;
+    if (sizeShape.rank().is_static())
+        sizeShape[2] = 1;
+    set_output_type(1, get_input_element_type(0), sizeShape);
+}
+
+std::shared_ptr<ov::Node> ToMeMerge::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2 || new_args.size() == 3, "Incorrect number of new arguments");
+    return std::make_shared<ToMeMerge>(new_args, r, class_token, distill_token);
+}
+
+bool ToMeMerge::visit_attributes(ov::AttributeVisitor& visitor) {
+    int class_token_i = static_cast<int>(class_token);
+    int distill_token_i = static_cast<int>(distill_token);
+    visitor.on_attribute("r", r);
+    visitor.on_attribute("class_token", class_token_i);
+    visitor.on_attribute("distill_token", distill_token_i);
+    class_token = static_cast<bool>(class_token_i);
+    distill_token = static_cast<bool>(distill_token_i);
+    return true;
+}
+
+bool ToMeMerge::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    const float* x = reinterpret_cast<float*>(inputs[0].data());
+    const float* metric = reinterpret_cast<float*>(inputs[1].data());
+    const float* sizes = inputs.size() > 2 ? reinterpret_cast<float*>(inputs[2].data()) : nullptr;
+
+    const auto shape = inputs[0].get_shape();
+    const size_t batch = shape[0];
+    const size_t numTokens = shape[1];
+    const size_t channels = shape[2];
+    const size_t metricChannels = inputs[1].get_shape()[2];
+    const size_t merged = static_cast<size_t>(get_merged(static_cast<int64_t>(numTokens)));
+    const size_t numOut = numTokens - merged;
+
+    const size_t numA = (numTokens + 1) / 2;  // even tokens, the sources
+    const size_t numB = numTokens / 2;        // odd tokens, the destinations
+    const size_t numUnmerged = numA - merged;
+
+    outputs[0].set_shape({batch, numOut, channels});
+    outputs[1].set_shape({batch, numOut, 1});
+    float* out = reinterpret_cast<float*>(outputs[0].data());
+    float* outSizes = reinterpret_cast<float*>(outputs[1].data());
+
+    // Too few tokens to merge, the reference skips the matching and keeps the token order
+    if (merged == 0) {
+        std::copy_n(x, batch * numTokens * channels, out);
+        if (sizes)
+            std::copy_n(sizes, batch * numTokens, outSizes);
+        else
+            std::fill_n(outSizes, batch * numTokens, 1.0f);
+        return true;
+    }
+
+    // Normalized metric. Every a token is matched with all the b tokens, so the rows are normalized once
+    // instead of in every dot product.
+    std::vector<float> normed(batch * numTokens * metricChannels);
+    ov::parallel_for2d(batch, numTokens, [&](size_t b, size_t t) {
+        const float* src = metric + (b * numTokens + t) * metricChannels;
+        float* dst = normed.data() + (b * numTokens + t) * metricChannels;
+        const float norm = std::sqrt(dot(src, src, metricChannels));
+        for (size_t c = 0; c < metricChannels; ++c)
+            dst[c] = src[c] / norm;
+    });
+
+    // Best match of every a token. Cosine similarities are computed row by row and never stored.
+    std::vector<float> nodeMax(batch * numA);
+    std::vector<size_t> nodeIdx(batch * numA);
+    const float minusInf = -std::numeric_limits<float>::infinity();
+    ov::parallel_for2d(batch, numA, [&](size_t b, size_t i) {
+        const float* a = normed.data() + (b * numTokens + 2 * i) * metricChannels;
+        float best = minusInf;
+        size_t bestIdx = 0;
+        if (!(class_token && i == 0)) {
+            for (size_t j = distill_token ? 1 : 0; j < numB; ++j) {
+                const float score = dot(a, normed.data() + (b * numTokens + 2 * j + 1) * metricChannels, metricChannels);
+                if (score > best) {
+                    best = score;
+                    bestIdx = j;
+                }
+            }
+        }
+        nodeMax[b * numA + i] = best;
+        nodeIdx[b * numA + i] = bestIdx;
+    });
+
+    // The r most similar a tokens are merged. Unmerged ones keep the order of similarity as in the reference,
+    // or the token order if the class token has to stay first. Sources of every destination are listed
+    // in the order of similarity, which is the order scatter_add adds them in.
+    std::vector<size_t> order(batch * numA);
+    std::vector<size_t> starts(batch * (numB + 1));
+    std::vector<size_t> sources(batch * merged);
+    ov::parallel_for(batch, [&](size_t b) {
+        size_t* edges = order.data() + b * numA;
+        const float* maxes = nodeMax.data() + b * numA;
+        std::iota(edges, edges + numA, size_t(0));
+        std::stable_sort(edges, edges + numA, [&](size_t lhs, size_t rhs) {
+            return maxes[lhs] > maxes[rhs];
+        });
+        if (class_token)
+            std::sort(edges + merged, edges + numA);
+
+        size_t* start = starts.data() + b * (numB + 1);
+        std::fill(start, start + numB + 1, 0);
+        for (size_t k = 0; k < merged; ++k)
+            ++start[nodeIdx[b * numA + edges[k]] + 1];
+        std::partial_sum(start, start + numB + 1, start);
+        std::vector<size_t> next(start, start + numB);
+        for (size_t k = 0; k < merged; ++k)
+            sources[b * merged + next[nodeIdx[b * numA + edges[k]]]++] = edges[k];
+    });
+
+    // Output rows are [unmerged a, b], or [a0, b0, other unmerged a, other b] with the distillation token
+    ov::parallel_for2d(batch, numOut, [&](size_t b, size_t row) {
+        size_t unmerged = numUnmerged, dst = 0;
+        if (!distill_token) {
+            if (row < numUnmerged)
+                unmerged = row;
+            else
+                dst = row - numUnmerged;
+        } else if (row == 0 || (row >= 2 && row <= numUnmerged)) {
+            unmerged = row == 0 ? 0 : row - 1;
+        } else {
+            dst = row == 1 ? 0 : row - numUnmerged;
+        }
+
+        const float* tokens = x + b * numTokens * channels;
+        const float* tokenSizes = sizes ? sizes + b * numTokens : nullptr;
+        float* dstRow = out + (b * numOut + row) * channels;
+        if (unmerged < numUnmerged) {
+            const size_t t = 2 * order[b * numA + merged + unmerged];
+            std::copy_n(tokens + t * channels, channels, dstRow);
+            outSizes[b * numOut + row] = tokenSizes ? tokenSizes[t] : 1.0f;
+            return;
+        }
+
+        // Weighted average of the destination and its sources
+        const size_t t = 2 * dst + 1;
+        float total = tokenSizes ? tokenSizes[t] : 1.0f;
+        for (size_t c = 0; c < channels; ++c)
+            dstRow[c] = tokens[t * channels + c] * total;
+        const size_t* start = starts.data() + b * (numB + 1);
+        for (size_t k = start[dst]; k < start[dst + 1]; ++k) {
+            const size_t s = 2 * sources[b * merged + k];
+            const float weight = tokenSizes ? tokenSizes[s] : 1.0f;
+            for (size_t c = 0; c < channels; ++c)
+                dstRow[c] += tokens[s * channels + c] * weight;
+            total += weight;
+        }
+        for (size_t c = 0; c < channels; ++c)
+            dstRow[c] /= total;
+        outSizes[b * numOut + row] = total;
+    });
+    return true;
+}
+
+bool ToMeMerge::has_evaluate() const {
+    for (size_t i = 0; i < get_input_size(); ++i)
+        if (get_input_element_type(i) != ov::element::f32)
+            return false;
+    return true;
+}
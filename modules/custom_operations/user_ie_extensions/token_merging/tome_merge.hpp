@@ -0,0 +1,39 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+// Token merging (ToMe) step of a transformer block: bipartite_soft_matching followed by merge_wavg of
+// tomeov/merge.py. Tokens are split into even (a) and odd (b) ones, every a token is matched with the most
+// cosine-similar b token by the metric, and the r best matched a tokens are merged into their b tokens as an
+// average weighted by the token sizes. Class and distillation tokens, if any, are never merged.
+// Inputs: tokens [B, N, C], metric [B, N, Cm] and, optionally, token sizes [B, N, 1] (ones if omitted).
+// Outputs: merged tokens [B, N - r, C] and their sizes [B, N - r, 1]; r is clamped to half of the tokens.
+class ToMeMerge : public ov::op::Op {
+public:
+    OPENVINO_OP("ToMeMerge");
+
+    ToMeMerge() = default;
+    ToMeMerge(const ov::OutputVector& args, int64_t r, bool class_token, bool distill_token);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+private:
+    // Number of tokens merged away for N input tokens
+    int64_t get_merged(int64_t numTokens) const;
+
+    int64_t r = 0;
+    bool class_token = false;
+    bool distill_token = false;
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,109 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "tome_unmerge.hpp"
+
+#include <algorithm>
+
+#include <openvino/core/parallel.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+bool is_index_type(const ov::element::Type& type) {
+    return type == ov::element::i32 || type == ov::element::i64;
+}
+
+template <typename T>
+void unmerge(const ov::TensorVector& inputs, float* out) {
+    const float* x = reinterpret_cast<float*>(inputs[0].data());
+    const T* tokenIdx = reinterpret_cast<T*>(inputs[1].data());
+    const T* dstIdx = reinterpret_cast<T*>(inputs[2].data());
+    const float* residual = inputs.size() > 3 ? reinterpret_cast<float*>(inputs[3].data()) : nullptr;
+
+    const auto shape = inputs[0].get_shape();
+    const size_t batch = shape[0];
+    const size_t numMerged = shape[1];
+    const size_t channels = shape[2];
+    const size_t numTokens = inputs[1].get_shape()[1];
+    const size_t r = numTokens - numMerged;
+
+    // Sources of the permutation read the row of their destination, destinations read their own row.
+    // The permutation visits every output position once, so no position is zero filled or written twice.
+    ov::parallel_for2d(batch, numTokens, [&](size_t b, size_t k) {
+        const T pos = tokenIdx[b * numTokens + k];
+        const T row = k < r ? dstIdx[b * r + k] : static_cast<T>(k - r);
+        OPENVINO_ASSERT(pos >= 0 && static_cast<size_t>(pos) < numTokens, "ToMeUnmerge token index is out of range");
+        OPENVINO_ASSERT(row >= 0 && static_cast<size_t>(row) < numMerged,
+                        "ToMeUnmerge destination index is out of range");
+
+        const float* src = x + (b * numMerged + row) * channels;
+        float* dst = out + (b * numTokens + pos) * channels;
+        if (residual) {
+            const float* res = residual + (b * numTokens + pos) * channels;
+            for (size_t c = 0; c < channels; ++c)
+                dst[c] = src[c] + res[c];
+        } else {
+            std::copy_n(src, channels, dst);
+        }
+    });
+}
+
+}  // namespace
+
+ToMeUnmerge::ToMeUnmerge(const ov::OutputVector& args) : Op(args) {
+    constructor_validate_and_infer_types();
+}
+
+void ToMeUnmerge::validate_and_infer_types() {
+    OPENVINO_ASSERT(get_input_size() == 3 || get_input_size() == 4,
+                    "ToMeUnmerge takes merged tokens, token indices, destination indices and a residual");
+    const auto& shape = get_input_partial_shape(0);
+    OPENVINO_ASSERT(shape.rank().compatible(3), "ToMeUnmerge tokens must have a shape [batch, tokens, channels]");
+    for (size_t i = 1; i < 3; ++i) {
+        OPENVINO_ASSERT(get_input_element_type(i).is_dynamic() || is_index_type(get_input_element_type(i)),
+                        "ToMeUnmerge indices must be i32 or i64");
+        OPENVINO_ASSERT(get_input_partial_shape(i).rank().compatible(3),
+                        "ToMeUnmerge indices must have a shape [batch, tokens, 1]");
+    }
+
+    auto outShape = shape;
+    if (shape.rank().is_static()) {
+        const auto& idxShape = get_input_partial_shape(1);
+        outShape[1] = idxShape.rank().is_static() ? idxShape[1] : ov::Dimension::dynamic();
+    }
+    set_output_type(0, get_input_element_type(0), outShape);
+}
+
+std::shared_ptr<ov::Node> ToMeUnmerge::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 3 || new_args.size() == 4, "Incorrect number of new arguments");
+    return std::make_shared<ToMeUnmerge>(new_args);
+}
+
+bool ToMeUnmerge::visit_attributes(ov::AttributeVisitor& visitor) {
+    return true;
+}
+
+bool ToMeUnmerge::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    const auto shape = inputs[0].get_shape();
+    const size_t numTokens = inputs[1].get_shape()[1];
+    OPENVINO_ASSERT(numTokens >= shape[1], "ToMeUnmerge has more merged tokens than tokens");
+    OPENVINO_ASSERT(inputs[2].get_shape()[1] == numTokens - shape[1],
+                    "ToMeUnmerge expects a destination index for every merged token");
+
+    outputs[0].set_shape({shape[0], numTokens, shape[2]});
+    float* out = reinterpret_cast<float*>(outputs[0].data());
+    if (inputs[1].get_element_type() == ov::element::i64)
+        unmerge<int64_t>(inputs, out);
+    else
+        unmerge<int32_t>(inputs, out);
+    return true;
+}
+
+bool ToMeUnmerge::has_evaluate() const {
+    return get_input_element_type(0) == ov::element::f32 && is_index_type(get_input_element_type(1)) &&
+           get_input_element_type(2) == get_input_element_type(1) &&
+           (get_input_size() < 4 || get_input_element_type(3) == ov::element::f32);
+}
@@ -0,0 +1,32 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+// Unmerge step of ToMe for Stable Diffusion: the unmerge of bipartite_soft_matching_random2d in
+// tomeov/merge.py. Every token of the merged tensor is written to the position of its destination token,
+// and every merged source token gets a copy of the destination it was merged into. Both use the indices of
+// the matching, so nothing is recomputed, and the output is written once instead of zero filled and scattered.
+// Inputs: merged tokens [B, N - r, C], token permutation [B, N, 1] (r sources followed by the destinations),
+// destinations of the sources [B, r, 1] and, optionally, a residual [B, N, C] added to the output.
+// Output: tokens [B, N, C].
+class ToMeUnmerge : public ov::op::Op {
+public:
+    OPENVINO_OP("ToMeUnmerge");
+
+    ToMeUnmerge() = default;
+    ToMeUnmerge(const ov::OutputVector& args);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+};
+
+}  // namespace TemplateExtension
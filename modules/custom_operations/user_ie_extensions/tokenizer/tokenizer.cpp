@@ -0,0 +1,117 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "tokenizer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <openvino/core/parallel.hpp>
+#include <openvino/op/constant.hpp>
+
+using namespace TemplateExtension;
+
+Tokenizer::Tokenizer(const ov::OutputVector& args, const TokenizerAttrs& attrs) : Op(args), attrs(attrs) {
+    constructor_validate_and_infer_types();
+}
+
+void Tokenizer::validate_and_infer_types() {
+    OPENVINO_ASSERT(attrs.mode == "bpe" || attrs.mode == "wordpiece", "Unsupported tokenizer mode: ", attrs.mode);
+    OPENVINO_ASSERT(get_input_size() == 3 || (get_input_size() == 2 && attrs.mode == "wordpiece"),
+                    "Tokenizer takes strings, vocabulary and, for BPE, merges");
+    OPENVINO_ASSERT(attrs.max_length >= 0, "Tokenizer max_length must be non-negative");
+    OPENVINO_ASSERT(attrs.pad_id >= std::numeric_limits<int32_t>::min() &&
+                        attrs.pad_id <= std::numeric_limits<int32_t>::max(),
+                    "Tokenizer pad_id is out of the int32 range");
+    for (size_t i = 0; i < get_input_size(); ++i) {
+        OPENVINO_ASSERT(get_input_element_type(i).is_dynamic() || get_input_element_type(i) == ov::element::u8,
+                        "Tokenizer input ", i, " must be a packed string tensor of u8 elements");
+        OPENVINO_ASSERT(get_input_partial_shape(i).rank().compatible(1),
+                        "Tokenizer input ", i, " must be a packed string tensor of rank 1");
+    }
+
+    const ov::Dimension length = attrs.max_length > 0 ? ov::Dimension(attrs.max_length) : ov::Dimension::dynamic();
+    const ov::PartialShape outShape{ov::Dimension::dynamic(), length};
+    set_output_type(0, ov::element::i32, outShape);  // input_ids
+    set_output_type(1, ov::element::i32, outShape);  // attention_mask
+}
+
+std::shared_ptr<ov::Node> Tokenizer::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2 || new_args.size() == 3, "Incorrect number of new arguments");
+    return std::make_shared<Tokenizer>(new_args, attrs);
+}
+
+bool Tokenizer::visit_attributes(ov::AttributeVisitor& visitor) {
+    visitor.on_attribute("mode", attrs.mode);
+    visitor.on_attribute("max_length", attrs.max_length);
+    visitor.on_attribute("pad_id", attrs.pad_id);
+    visitor.on_attribute("unk_token", attrs.unk_token);
+    visitor.on_attribute("lowercase", attrs.lowercase);
+    visitor.on_attribute("continuing_prefix", attrs.continuing_prefix);
+    visitor.on_attribute("end_of_word_suffix", attrs.end_of_word_suffix);
+    visitor.on_attribute("word_prefix", attrs.word_prefix);
+    return true;
+}
+
+std::shared_ptr<const TokenizerModel> Tokenizer::get_model(const ov::TensorVector& inputs) const {
+    const ov::Tensor* merges = inputs.size() > 2 ? &inputs[2] : nullptr;
+    bool constTables = true;
+    for (size_t i = 1; i < get_input_size(); ++i)
+        constTables = constTables && ov::as_type_ptr<ov::op::v0::Constant>(input_value(i).get_node_shared_ptr());
+    // Vocabularies take megabytes, so tables of constants are built once and shared by all the inferences
+    if (!constTables)
+        return build_tokenizer_model(inputs[1], merges, attrs);
+    std::call_once(modelOnce, [&]() {
+        constModel = build_tokenizer_model(inputs[1], merges, attrs);
+    });
+    return constModel;
+}
+
+bool Tokenizer::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    const openvino_extensions::strings_view texts(inputs[0]);
+    const auto model = get_model(inputs);
+
+    const size_t batch = texts.size();
+    const size_t maxTokens = attrs.max_length > 0 ? static_cast<size_t>(attrs.max_length)
+                                                  : std::numeric_limits<size_t>::max();
+
+    // Strings are independent, so every thread tokenizes a range of them. Texts differ in length and the
+    // sequence length is known after all of them are tokenized, so the ids are padded in a second pass.
+    std::vector<std::vector<int32_t>> ids(batch);
+    ov::parallel_for(batch, [&](size_t b) {
+        const auto text = texts[b];
+        model->encode(text.data(), text.size(), maxTokens, ids[b]);
+    });
+
+    size_t length = 0;
+    if (attrs.max_length > 0) {
+        length = static_cast<size_t>(attrs.max_length);
+    } else {
+        for (const auto& seq : ids)
+            length = std::max(length, seq.size());
+    }
+
+    outputs[0].set_shape({batch, length});
+    outputs[1].set_shape({batch, length});
+    int32_t* inputIds = outputs[0].data<int32_t>();
+    int32_t* attentionMask = outputs[1].data<int32_t>();
+    const int32_t padId = static_cast<int32_t>(attrs.pad_id);
+    ov::parallel_for(batch, [&](size_t b) {
+        const auto& seq = ids[b];
+        int32_t* rowIds = inputIds + b * length;
+        int32_t* rowMask = attentionMask + b * length;
+        std::copy(seq.begin(), seq.end(), rowIds);
+        std::fill(rowIds + seq.size(), rowIds + length, padId);
+        std::fill(rowMask, rowMask + seq.size(), 1);
+        std::fill(rowMask + seq.size(), rowMask + length, 0);
+    });
+    return true;
+}
+
+bool Tokenizer::has_evaluate() const {
+    for (size_t i = 0; i < get_input_size(); ++i)
+        if (get_input_element_type(i) != ov::element::u8)
+            return false;
+    return true;
+}
@@ -0,0 +1,43 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <mutex>
+
+#include <openvino/op/op.hpp>
+
+#include "tokenizer_model.hpp"
+
+namespace TemplateExtension {
+
+// Tokenizes a batch of strings packed into a u8 tensor by openvino_extensions::pack_strings.
+// Inputs: packed strings, packed vocabulary (the id of a token is its index) and, for BPE, packed merges
+// "left right" ordered by priority. Outputs are i32 input_ids and attention_mask of shape [batch, length],
+// the batch size is stored in the packed tensor, so both dimensions are known at inference only.
+// Words are split at whitespace, BPE supports the end_of_word_suffix (CLIP) and word_prefix (SentencePiece)
+// vocabularies but not byte-level BPE (GPT-2), see TokenizerModel.
+class Tokenizer : public ov::op::Op {
+public:
+    OPENVINO_OP("Tokenizer");
+
+    Tokenizer() = default;
+    Tokenizer(const ov::OutputVector& args, const TokenizerAttrs& attrs);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+private:
+    std::shared_ptr<const TokenizerModel> get_model(const ov::TensorVector& inputs) const;
+
+    TokenizerAttrs attrs;
+    // Tables of the constant vocabulary and merges, built by the first inference of the node
+    mutable std::once_flag modelOnce;
+    mutable std::shared_ptr<const TokenizerModel> constModel;
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,308 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "tokenizer_model.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <openvino/core/except.hpp>
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Words of more characters than this are a single unknown token in WordPiece, as in BERT
+constexpr size_t max_wordpiece_chars = 100;
+
+uint64_t hash_bytes(const char* data, size_t size, uint64_t seed) {
+    uint64_t hash = seed ^ (size * 0x9E3779B97F4A7C15ull);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    uint64_t tail = 0;
+    if (i < size)
+        std::memcpy(&tail, data + i, size - i);
+    hash = (hash ^ tail) * 0xC4CEB9FE1A85EC53ull;
+    return hash ^ (hash >> 29);
+}
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool is_punctuation(char c) {
+    return (c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+}
+
+// Length of the UTF-8 character starting with the byte, invalid bytes are characters of their own
+size_t char_length(unsigned char c) {
+    if (c < 0xC0)
+        return 1;
+    return c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+}
+
+bool is_continuation(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// Number of the UTF-8 characters of the text, counted as char_length splits them
+size_t count_chars(const char* text, size_t size) {
+    size_t count = 0;
+    for (size_t pos = 0; pos < size; ++count)
+        pos += char_length(static_cast<unsigned char>(text[pos]));
+    return count;
+}
+
+uint64_t pair_key(int32_t left, int32_t right) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(left)) << 32) | static_cast<uint32_t>(right);
+}
+
+// Symbol of a word being merged by BPE, linked to its neighbours by their indices, -1 at the ends
+struct Symbol {
+    int32_t id;  // -1 for characters out of the vocabulary
+    int32_t prev;
+    int32_t next;
+};
+
+// Mergeable pair of adjacent symbols. The symbols may be merged with other ones before the pair comes out of
+// the heap, so it is applied only if they are still adjacent and keep their ids.
+struct MergeCandidate {
+    int32_t rank;
+    int32_t id;  // of the merged symbol
+    int32_t left;
+    int32_t right;
+    int32_t leftId;
+    int32_t rightId;
+};
+
+// Heap order: the highest priority merge first, the leftmost one among equal pairs
+struct LaterMerge {
+    bool operator()(const MergeCandidate& a, const MergeCandidate& b) const {
+        return a.rank != b.rank ? a.rank > b.rank : a.left > b.left;
+    }
+};
+
+}  // namespace
+
+Vocab::Vocab(const openvino_extensions::strings_view& tokens) {
+    offsets.reserve(tokens.size() + 1);
+    offsets.push_back(0);
+    for (const auto token : tokens) {
+        chars.insert(chars.end(), token.begin(), token.end());
+        offsets.push_back(chars.size());
+    }
+
+    // At most half of the slots are used, so probe sequences stay short
+    size_t capacity = 16;
+    while (capacity < 2 * tokens.size())
+        capacity *= 2;
+    mask = capacity - 1;
+    slots.assign(capacity, -1);
+    for (size_t id = 0; id < tokens.size(); ++id) {
+        const char* data = chars.data() + offsets[id];
+        const size_t size = offsets[id + 1] - offsets[id];
+        // Duplicates keep the first id
+        if (find(data, size) >= 0)
+            continue;
+        size_t slot = hash_bytes(data, size, 0) & mask;
+        while (slots[slot] >= 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = static_cast<int32_t>(id);
+    }
+}
+
+int32_t Vocab::find(const char* data, size_t size) const {
+    for (size_t slot = hash_bytes(data, size, 0) & mask;; slot = (slot + 1) & mask) {
+        const int32_t id = slots[slot];
+        if (id < 0)
+            return -1;
+        const size_t begin = offsets[id];
+        if (offsets[id + 1] - begin == size && std::memcmp(chars.data() + begin, data, size) == 0)
+            return id;
+    }
+}
+
+TokenizerModel::TokenizerModel(const openvino_extensions::strings_view& vocabulary,
+                               const openvino_extensions::strings_view* mergesView,
+                               const TokenizerAttrs& attrs)
+    : vocab(vocabulary),
+      attrs(attrs),
+      wordpiece(attrs.mode == "wordpiece") {
+    OPENVINO_ASSERT(vocabulary.size() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                    "Tokenizer vocabulary is too large");
+    unk = attrs.unk_token.empty() ? -1 : vocab.find(attrs.unk_token.data(), attrs.unk_token.size());
+    if (wordpiece || !mergesView)
+        return;
+
+    // Merges are "left right" pairs of tokens, the earlier ones have higher priority
+    std::string merged;
+    merges.reserve(mergesView->size());
+    for (size_t rank = 0; rank < mergesView->size(); ++rank) {
+        const auto merge = (*mergesView)[rank];
+        const char* space = std::find(merge.begin(), merge.end(), ' ');
+        OPENVINO_ASSERT(space != merge.end(), "Tokenizer merge ", rank, " is not a pair of tokens separated by a space");
+        const size_t leftSize = space - merge.begin();
+        const int32_t left = vocab.find(merge.data(), leftSize);
+        const int32_t right = vocab.find(space + 1, merge.end() - space - 1);
+        merged.assign(merge.data(), leftSize);
+        merged.append(space + 1, merge.end());
+        const int32_t id = vocab.find(merged.data(), merged.size());
+        OPENVINO_ASSERT(left >= 0 && right >= 0 && id >= 0,
+                        "Tokenizer merge ", rank, " has a token out of the vocabulary");
+        // Repeated pairs keep the higher priority
+        merges.insert({pair_key(left, right), Merge{static_cast<int32_t>(rank), id}});
+    }
+}
+
+void TokenizerModel::encode(const char* text, size_t size, size_t maxTokens, std::vector<int32_t>& ids) const {
+    static thread_local std::string lowered;
+    if (attrs.lowercase) {
+        lowered.assign(text, size);
+        for (auto& c : lowered)
+            c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        text = lowered.data();
+    }
+
+    size_t pos = 0;
+    while (pos < size && ids.size() < maxTokens) {
+        if (is_space(text[pos])) {
+            ++pos;
+            continue;
+        }
+        size_t end = pos + 1;
+        if (!wordpiece || !is_punctuation(text[pos])) {
+            while (end < size && !is_space(text[end]) && !(wordpiece && is_punctuation(text[end])))
+                ++end;
+        }
+        if (wordpiece)
+            encode_wordpiece(text + pos, end - pos, ids);
+        else
+            encode_bpe(text + pos, end - pos, ids);
+        pos = end;
+    }
+    if (ids.size() > maxTokens)
+        ids.resize(maxTokens);
+}
+
+void TokenizerModel::encode_bpe(const char* word, size_t size, std::vector<int32_t>& ids) const {
+    static thread_local std::vector<Symbol> symbols;
+    static thread_local std::vector<MergeCandidate> candidates;
+    static thread_local std::string lastSymbol;
+    symbols.clear();
+    candidates.clear();
+    // The prefix is a symbol of its own, merged with the first character by the merges of the vocabulary
+    if (!attrs.word_prefix.empty())
+        symbols.push_back(Symbol{vocab.find(attrs.word_prefix.data(), attrs.word_prefix.size()), -1, 1});
+    for (size_t pos = 0; pos < size;) {
+        const size_t length = std::min(char_length(static_cast<unsigned char>(word[pos])), size - pos);
+        int32_t id;
+        if (pos + length == size && !attrs.end_of_word_suffix.empty()) {
+            lastSymbol.assign(word + pos, length);
+            lastSymbol += attrs.end_of_word_suffix;
+            id = vocab.find(lastSymbol.data(), lastSymbol.size());
+        } else {
+            id = vocab.find(word + pos, length);
+        }
+        const int32_t index = static_cast<int32_t>(symbols.size());
+        symbols.push_back(Symbol{id, index - 1, index + 1});
+        pos += length;
+    }
+    if (symbols.empty())
+        return;
+    symbols.back().next = -1;
+
+    // Characters out of the vocabulary are -1 and never merged
+    auto addCandidate = [&](int32_t left) {
+        const int32_t right = symbols[left].next;
+        if (right < 0 || symbols[left].id < 0 || symbols[right].id < 0)
+            return;
+        const auto it = merges.find(pair_key(symbols[left].id, symbols[right].id));
+        if (it == merges.end())
+            return;
+        candidates.push_back(
+            MergeCandidate{it->second.rank, it->second.id, left, right, symbols[left].id, symbols[right].id});
+        std::push_heap(candidates.begin(), candidates.end(), LaterMerge());
+    };
+    for (int32_t i = 0; i + 1 < static_cast<int32_t>(symbols.size()); ++i)
+        addCandidate(i);
+
+    // Merges the pair of the highest priority, the leftmost one among equal pairs, until no pair is mergeable.
+    // Every merge replaces the left symbol, unlinks the right one and adds the pairs with the new neighbours.
+    while (!candidates.empty()) {
+        std::pop_heap(candidates.begin(), candidates.end(), LaterMerge());
+        const MergeCandidate candidate = candidates.back();
+        candidates.pop_back();
+        Symbol& left = symbols[candidate.left];
+        if (left.next != candidate.right || left.id != candidate.leftId ||
+            symbols[candidate.right].id != candidate.rightId)
+            continue;
+
+        left.id = candidate.id;
+        left.next = symbols[candidate.right].next;
+        if (left.next >= 0)
+            symbols[left.next].prev = candidate.left;
+        symbols[candidate.right].id = -1;  // unlinked, so the pairs starting with it are never applied
+        if (left.prev >= 0)
+            addCandidate(left.prev);
+        addCandidate(candidate.left);
+    }
+
+    for (int32_t i = 0; i >= 0; i = symbols[i].next) {
+        const int32_t id = symbols[i].id < 0 ? unk : symbols[i].id;
+        if (id >= 0)
+            ids.push_back(id);
+    }
+}
+
+void TokenizerModel::encode_wordpiece(const char* word, size_t size, std::vector<int32_t>& ids) const {
+    static thread_local std::string piece;
+    const size_t first = ids.size();
+    bool known = count_chars(word, size) <= max_wordpiece_chars;
+    for (size_t start = 0; known && start < size;) {
+        // Longest piece first, ends of the pieces are kept at character boundaries
+        int32_t id = -1;
+        size_t end = size;
+        for (; end > start; --end) {
+            if (end < size && is_continuation(word[end]))
+                continue;
+            if (start == 0) {
+                id = vocab.find(word, end);
+            } else {
+                piece.assign(attrs.continuing_prefix);
+                piece.append(word + start, end - start);
+                id = vocab.find(piece.data(), piece.size());
+            }
+            if (id >= 0)
+                break;
+        }
+        if (id < 0)
+            known = false;
+        else
+            ids.push_back(id);
+        start = end;
+    }
+
+    // A word with a piece out of the vocabulary is a single unknown token
+    if (!known) {
+        ids.resize(first);
+        if (unk >= 0)
+            ids.push_back(unk);
+    }
+}
+
+std::shared_ptr<const TokenizerModel> TemplateExtension::build_tokenizer_model(const ov::Tensor& vocabulary,
+                                                                               const ov::Tensor* merges,
+                                                                               const TokenizerAttrs& attrs) {
+    const openvino_extensions::strings_view vocabView(vocabulary);
+    if (!merges)
+        return std::make_shared<const TokenizerModel>(vocabView, nullptr, attrs);
+    const openvino_extensions::strings_view mergesView(*merges);
+    return std::make_shared<const TokenizerModel>(vocabView, &mergesView, attrs);
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <openvino/runtime/tensor.hpp>
+#include <openvino_extensions/strings.hpp>
+
+namespace TemplateExtension {
+
+// Attributes of the Tokenizer operation
+struct TokenizerAttrs {
+    std::string mode = "bpe";               // "bpe" or "wordpiece"
+    int64_t max_length = 0;                 // sequences are truncated and padded to it, 0 pads to the longest one
+    int64_t pad_id = 0;
+    std::string unk_token;                  // pieces out of the vocabulary are dropped if it is empty
+    bool lowercase = false;                 // ASCII letters only
+    std::string continuing_prefix = "##";   // WordPiece prefix of the pieces which continue a word
+    std::string end_of_word_suffix;         // BPE suffix of the last symbol of a word, e.g. "</w>"
+    std::string word_prefix;                // BPE symbol put before every word, e.g. "\xE2\x96\x81" of SentencePiece
+};
+
+// Open addressing hash table of the tokens of a vocabulary, the id of a token is its index. Keys are compared
+// with the characters of the tokens, so pieces of the text are looked up without allocations.
+class Vocab {
+public:
+    explicit Vocab(const openvino_extensions::strings_view& tokens);
+
+    // Id of the token or -1 if it is not in the vocabulary
+    int32_t find(const char* data, size_t size) const;
+    size_t size() const {
+        return offsets.size() - 1;
+    }
+
+private:
+    std::vector<char> chars;
+    std::vector<size_t> offsets;
+    std::vector<int32_t> slots;  // ids of the tokens, -1 marks an empty slot
+    size_t mask = 0;
+};
+
+// Splits texts into words at whitespace (and ASCII punctuation for WordPiece) and the words into the tokens
+// of a vocabulary. BPE starts from the UTF-8 characters of a word and applies the merges in the order of their
+// priority; WordPiece takes the longest prefix of the rest of the word found in the vocabulary.
+// The whitespace itself is dropped. BPE vocabularies which mark word boundaries with end_of_word_suffix (CLIP) or
+// with a word_prefix symbol (SentencePiece) are supported. Byte-level BPE (GPT-2, "\xC4\xA0" for a space) is not:
+// its vocabulary holds bytes mapped to printable characters and its texts are split by a regular expression.
+class TokenizerModel {
+public:
+    TokenizerModel(const openvino_extensions::strings_view& vocabulary,
+                   const openvino_extensions::strings_view* merges,
+                   const TokenizerAttrs& attrs);
+
+    // Appends the ids of the tokens of the text, up to maxTokens of them in total
+    void encode(const char* text, size_t size, size_t maxTokens, std::vector<int32_t>& ids) const;
+
+private:
+    struct Merge {
+        int32_t rank;
+        int32_t id;
+    };
+
+    void encode_bpe(const char* word, size_t size, std::vector<int32_t>& ids) const;
+    void encode_wordpiece(const char* word, size_t size, std::vector<int32_t>& ids) const;
+
+    Vocab vocab;
+    std::unordered_map<uint64_t, Merge> merges;  // (left << 32 | right) ids of a pair to its rank and merged id
+    TokenizerAttrs attrs;
+    bool wordpiece;
+    int32_t unk;
+};
+
+// Builds the tables of the vocabulary and merges tensors, merges are nullptr for WordPiece
+std::shared_ptr<const TokenizerModel> build_tokenizer_model(const ov::Tensor& vocabulary,
+                                                            const ov::Tensor* merges,
+                                                            const TokenizerAttrs& attrs);
+
+}  // namespace TemplateExtension
@@ -4,9 +4,15 @@
 #ifndef LLAMA_CPP_COMPILED_MODEL_HPP
 #define LLAMA_CPP_COMPILED_MODEL_HPP
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "llama.h"
 #include "openvino/runtime/icompiled_model.hpp"
 #include "openvino/runtime/isync_infer_request.hpp"
+#include "scheduler.hpp"
 
 namespace ov {
 namespace llama_cpp_plugin {
@@ -15,7 +21,12 @@ class LlamaCppPlugin;
 class LlamaCppState;
 class LlamaCppModel : public ICompiledModel {
 public:
-    LlamaCppModel(const std::string& gguf_fname, const std::shared_ptr<const IPlugin>& plugin, size_t num_threads = 0);
+    LlamaCppModel(const std::string& gguf_fname,
+                  const std::shared_ptr<const IPlugin>& plugin,
+                  size_t num_threads = 0,
+                  bool last_logits_only = false,
+                  uint32_t kv_cache_size = 0,
+                  uint32_t num_requests = 0);
     /**
      * @brief Export compiled model to stream
      *
@@ -58,13 +69,29 @@ protected:
      */
     virtual std::shared_ptr<ov::ISyncInferRequest> create_sync_infer_request() const override;
 
+    /**
+     * @brief Admits an infer request to the KV cache of a scheduler with room for it
+     *
+     * If LLAMA_CPP_KV_CACHE_SIZE and PERFORMANCE_HINT_NUM_REQUESTS are not set and all the schedulers are full, a
+     * scheduler with a context for one more request is added. Otherwise a request beyond the capacity throws.
+     *
+     * @return Scheduler to decode the steps of the request and to release it with
+     */
+    LlamaCppScheduler& admit_request() const;
+
 private:
     gguf_context* m_gguf_ctx = nullptr;
     std::string m_gguf_fname;
     size_t m_num_threads;
+    std::atomic<bool> m_last_token_logits_only;
+    uint32_t m_kv_cache_size;
+    uint32_t m_num_requests;
 
     llama_model* m_llama_model_ptr = nullptr;
-    llama_context* m_llama_ctx = nullptr;
+    // Own the llama_contexts of the infer requests. The first one is shared by as many requests as it has room for,
+    // the others are added for the requests beyond its capacity if the capacity is not given.
+    mutable std::mutex m_schedulers_mutex;
+    mutable std::vector<std::unique_ptr<LlamaCppScheduler>> m_schedulers;
     std::shared_ptr<ov::Model> m_fake_model;
 
     std::vector<ov::Output<const ov::Node>> m_fake_inputs;
@@ -12,7 +12,7 @@ namespace llama_cpp_plugin {
 
 class LlamaCppSyncInferRequest : public ISyncInferRequest {
 public:
-    explicit LlamaCppSyncInferRequest(const std::shared_ptr<const LlamaCppModel>& compiled_model, size_t num_threads);
+    explicit LlamaCppSyncInferRequest(const std::shared_ptr<const LlamaCppModel>& compiled_model);
     virtual ~LlamaCppSyncInferRequest() override;
 
     virtual void set_tensors_impl(const ov::Output<const ov::Node> port,
@@ -24,7 +24,9 @@ public:
 
 private:
     std::shared_ptr<const LlamaCppModel> m_compiled_model_ptr;
-    llama_context* m_llama_ctx;
+
+    // Sequences of the request in the KV cache shared with the other requests, the states reset the current ones
+    std::shared_ptr<LlamaCppSequences> m_sequences = std::make_shared<LlamaCppSequences>();
 };
 
 }  // namespace llama_cpp_plugin
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LLAMA_CPP_PROPERTIES_HPP
+#define LLAMA_CPP_PROPERTIES_HPP
+
+#include "openvino/runtime/properties.hpp"
+
+namespace ov {
+namespace llama_cpp_plugin {
+
+/**
+ * @brief Return the logits for the last position of each sequence only.
+ *
+ * The `logits` output then has the shape [batch, 1, n_vocab] instead of [batch, sequence_length, n_vocab], and
+ * llama.cpp does not extract the logits of the other positions. Enable it for generation, where only the next token
+ * distribution is read. Can be passed to `compile_model` or set on the compiled model, `false` by default.
+ */
+static constexpr ov::Property<bool, ov::PropertyMutability::RW> last_token_logits_only{
+    "LLAMA_CPP_LAST_TOKEN_LOGITS_ONLY"};
+
+/**
+ * @brief Number of tokens in the KV cache shared by all the infer requests of a compiled model.
+ *
+ * The infer requests are decoded together in a single llama.cpp context, so the history of all their sequences has
+ * to fit into its KV cache. Each request takes the train-time context size of the model in it, so a cache of N
+ * contexts runs up to N infer requests at once and the next one throws on `infer()` until another request is
+ * destroyed. Can be passed to `compile_model` only, 0 (the default) makes room for `ov::hint::num_requests` requests.
+ * If the hint is not set either, the cache has room for one request and every other request gets a context of its
+ * own, without batching. `ov::optimal_number_of_infer_requests` of the compiled model reports the number of requests
+ * sharing the cache.
+ */
+static constexpr ov::Property<uint32_t, ov::PropertyMutability::RW> kv_cache_size{"LLAMA_CPP_KV_CACHE_SIZE"};
+
+}  // namespace llama_cpp_plugin
+}  // namespace ov
+
+#endif  // LLAMA_CPP_PROPERTIES_HPP
@@ -0,0 +1,136 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LLAMA_CPP_SCHEDULER_HPP
+#define LLAMA_CPP_SCHEDULER_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "llama.h"
+
+namespace ov {
+namespace llama_cpp_plugin {
+
+/**
+ * @brief Continuous batching of the decode steps of all infer requests of a compiled model
+ *
+ * The infer requests share a single llama_context, every sequence of every request has a distinct seq_id in its KV
+ * cache. A request submitting a decode step while the context is idle decodes all the steps queued so far in as few
+ * llama_decode calls as the batch size allows, the others wait for it and get their logits written to their outputs.
+ *
+ * Each infer request gets the train-time context size of the model in the KV cache for all its sequences, as it did
+ * with a llama_context of its own, so the cache of n_ctx tokens admits n_ctx / n_ctx_train requests at a time. Unless
+ * kv_cache_size is given, the cache has room for num_requests requests, or for a single one if it is 0.
+ */
+class LlamaCppScheduler {
+public:
+    /**
+     * @brief Tokens of one or more sequences of the same length, decoded by a single infer() call
+     */
+    struct DecodeStep {
+        const int64_t* token_ids;     // [n_sequences, sequence_length]
+        const int64_t* position_ids;  // [n_sequences, sequence_length]
+        const llama_seq_id* seq_ids;  // [n_sequences]
+        size_t n_sequences;
+        size_t sequence_length;
+        bool last_token_logits_only;
+        float* logits;  // [n_sequences, last_token_logits_only ? 1 : sequence_length, n_vocab]
+    };
+
+    LlamaCppScheduler(llama_model* model, size_t num_threads, uint32_t kv_cache_size, uint32_t num_requests);
+    ~LlamaCppScheduler();
+
+    LlamaCppScheduler(const LlamaCppScheduler&) = delete;
+    LlamaCppScheduler& operator=(const LlamaCppScheduler&) = delete;
+
+    /**
+     * @brief Admits an infer request to the KV cache, returns false if it holds as many requests as fit into it
+     */
+    bool admit_request();
+
+    /**
+     * @brief Appends seq_ids not used by other sequences to the ones of an admitted infer request until there are
+     * n_sequences
+     *
+     * The KV cache of the new sequences is empty.
+     */
+    void acquire_sequences(std::vector<llama_seq_id>& seq_ids, size_t n_sequences);
+
+    /**
+     * @brief Clears the KV cache of all the sequences of an admitted infer request and makes room for another request
+     */
+    void release_request(const std::vector<llama_seq_id>& seq_ids);
+
+    /**
+     * @brief Clears the KV cache of the sequence
+     */
+    void clear_sequence(llama_seq_id seq_id);
+
+    /**
+     * @brief Decodes the step together with the steps of other requests, blocks until its logits are written
+     */
+    void decode(const DecodeStep& step);
+
+    size_t get_n_vocab() const {
+        return m_n_vocab;
+    }
+
+    size_t get_max_requests() const {
+        return m_max_requests;
+    }
+
+    size_t get_n_ctx_per_request() const {
+        return m_n_ctx_per_request;
+    }
+
+private:
+    struct PendingStep {
+        const DecodeStep* step;
+        bool done = false;
+        std::exception_ptr error;
+    };
+
+    // Decodes the steps in batches of at most m_n_batch tokens, called with m_context_mutex locked
+    void decode_steps(const std::vector<PendingStep*>& steps);
+    // Decodes the tokens added to m_batch and copies their logits to m_batch_logits
+    void flush_batch();
+    // Removes the KV cache entries of the step and the ones after it, called with m_context_mutex locked
+    void remove_step_tokens(const DecodeStep& step);
+
+    llama_context* m_llama_ctx = nullptr;
+    size_t m_n_vocab;
+    size_t m_n_batch;
+    size_t m_n_ctx_per_request;
+    size_t m_max_requests;
+
+    // Guards the llama_context, held while decoding and while clearing the KV cache
+    std::mutex m_context_mutex;
+    llama_batch m_batch = {};
+    std::vector<float*> m_batch_logits;  // output row of every token of m_batch or nullptr
+
+    // Guards the queue of the steps, the decoding flag, the seq_ids and the number of admitted requests
+    std::mutex m_queue_mutex;
+    std::condition_variable m_queue_cv;
+    std::vector<PendingStep*> m_queue;
+    bool m_decoding = false;
+
+    llama_seq_id m_next_seq_id = 0;
+    std::vector<llama_seq_id> m_free_seq_ids;
+    size_t m_n_requests = 0;
+};
+
+/**
+ * @brief Sequences of an infer request in the KV cache, shared by the request with its variable states
+ */
+struct LlamaCppSequences {
+    LlamaCppScheduler* scheduler = nullptr;  // the request is admitted to it on its first infer(), null before
+    std::vector<llama_seq_id> seq_ids;       // one per batch element
+};
+
+}  // namespace llama_cpp_plugin
+}  // namespace ov
+
+#endif  // LLAMA_CPP_SCHEDULER_HPP
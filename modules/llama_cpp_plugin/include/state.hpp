@@ -12,16 +12,24 @@ namespace llama_cpp_plugin {
 class LlamaCppState : public IVariableState {
 public:
     LlamaCppState() = delete;
-    LlamaCppState(llama_context* llama_context_ptr)
-        : m_llama_ctx_ptr(llama_context_ptr),
-          IVariableState("llama_cpp_state") {}
+    // The KV cache is shared by all the infer requests of the model, so only the sequences of one request are reset
+    LlamaCppState(const std::shared_ptr<const LlamaCppModel>& compiled_model,
+                  const std::shared_ptr<const LlamaCppSequences>& sequences)
+        : IVariableState("llama_cpp_state"),
+          m_compiled_model_ptr(compiled_model),
+          m_sequences(sequences) {}
     void reset() override {
-        OPENVINO_ASSERT(m_llama_ctx_ptr != nullptr);
-        llama_kv_cache_clear(m_llama_ctx_ptr);
+        OPENVINO_ASSERT(m_compiled_model_ptr != nullptr);
+        // the sequences the request has now, including the ones acquired after the state was queried
+        for (llama_seq_id seq_id : m_sequences->seq_ids) {
+            m_sequences->scheduler->clear_sequence(seq_id);
+        }
     }
 
 private:
-    llama_context* m_llama_ctx_ptr;
+    // keeps the schedulers alive
+    std::shared_ptr<const LlamaCppModel> m_compiled_model_ptr;
+    std::shared_ptr<const LlamaCppSequences> m_sequences;
 };
 }  // namespace llama_cpp_plugin
 }  // namespace ov
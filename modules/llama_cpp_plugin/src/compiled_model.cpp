@@ -8,30 +8,51 @@
 #include <openvino/op/constant.hpp>
 #include <openvino/opsets/opset13.hpp>
 #include <openvino/runtime/properties.hpp>
+#include <openvino/runtime/threading/executor_manager.hpp>
+#include <openvino/runtime/threading/istreams_executor.hpp>
 #include <openvino/util/log.hpp>
 
 #include "infer_request.hpp"
 #include "plugin.hpp"
+#include "properties.hpp"
+
+namespace {
+static constexpr const char* stream_executor_name = "LlamaCppStreamsExecutor";
+}  // namespace
 
 namespace ov {
 namespace llama_cpp_plugin {
 
 LlamaCppModel::~LlamaCppModel() {
+    m_schedulers.clear();  // frees the llama_contexts, which has to be done before freeing the model
     llama_free_model(m_llama_model_ptr);
     llama_backend_free();
 }
 
 LlamaCppModel::LlamaCppModel(const std::string& gguf_fname,
                              const std::shared_ptr<const IPlugin>& plugin,
-                             size_t num_threads)
+                             size_t num_threads,
+                             bool last_logits_only,
+                             uint32_t kv_cache_size,
+                             uint32_t num_requests)
     : ICompiledModel(nullptr, plugin),
       m_gguf_fname(gguf_fname),
-      m_num_threads(num_threads) {
+      m_num_threads(num_threads),
+      m_last_token_logits_only(last_logits_only),
+      m_kv_cache_size(kv_cache_size),
+      m_num_requests(num_requests) {
     OPENVINO_DEBUG << "llama_cpp_plugin: loading llama model directly from GGUF... " << std::endl;
     llama_model_params mparams = llama_model_default_params();
     mparams.n_gpu_layers = 99;
     m_llama_model_ptr = llama_load_model_from_file(gguf_fname.c_str(), mparams);
     OPENVINO_DEBUG << "llama_cpp_plugin: llama model loaded successfully from GGUF..." << std::endl;
+    m_schedulers.emplace_back(new LlamaCppScheduler(m_llama_model_ptr, m_num_threads, m_kv_cache_size, num_requests));
+
+    // The asynchronous infer requests run infer() in the streams, one stream per request the shared KV cache has room
+    // for lets their decode steps meet in the scheduler
+    const int num_streams = static_cast<int>(m_schedulers.front()->get_max_requests());
+    set_task_executor(get_plugin()->get_executor_manager()->get_idle_cpu_streams_executor(
+        ov::threading::IStreamsExecutor::Config{stream_executor_name, num_streams}));
 
     auto input_ids = std::make_shared<ov::opset13::Parameter>(ov::element::Type_t::i64, ov::PartialShape({-1, -1}));
     auto fake_convert = std::make_shared<ov::opset13::Convert>(input_ids->output(0), ov::element::Type_t::f32);
@@ -71,19 +92,64 @@ std::shared_ptr<const ov::Model> LlamaCppModel::get_runtime_model() const {
 }
 
 void LlamaCppModel::set_property(const ov::AnyMap& properties) {
-    OPENVINO_DEBUG << "llama_cpp_plugin: attempted to set_property (did nothing)";
+    for (const auto& map_entry : properties) {
+        if (last_token_logits_only == map_entry.first) {
+            m_last_token_logits_only = map_entry.second.as<bool>();
+        } else {
+            OPENVINO_DEBUG << "llama_cpp_plugin: attempted to set_property " << map_entry.first << " (did nothing)";
+        }
+    }
 }
 
 ov::Any LlamaCppModel::get_property(const std::string& name) const {
     if (ov::supported_properties == name) {
-        return decltype(ov::supported_properties)::value_type(std::vector<PropertyName>());
+        return decltype(ov::supported_properties)::value_type(std::vector<PropertyName>(
+            {PropertyName(last_token_logits_only.name(), last_token_logits_only.mutability),
+             PropertyName(kv_cache_size.name(), ov::PropertyMutability::RO),
+             PropertyName(ov::optimal_number_of_infer_requests.name(), ov::PropertyMutability::RO)}));
+    }
+    if (last_token_logits_only == name) {
+        return m_last_token_logits_only.load();
+    }
+    if (kv_cache_size == name) {
+        return m_kv_cache_size;
+    }
+    if (ov::optimal_number_of_infer_requests == name) {
+        // as many infer requests as the shared KV cache has room for
+        std::lock_guard<std::mutex> lock(m_schedulers_mutex);
+        return static_cast<uint32_t>(m_schedulers.front()->get_max_requests());
     }
     OPENVINO_THROW_NOT_IMPLEMENTED("llama_cpp_plugin: Not Implemented");
 }
 
+LlamaCppScheduler& LlamaCppModel::admit_request() const {
+    std::lock_guard<std::mutex> lock(m_schedulers_mutex);
+    for (const auto& scheduler : m_schedulers) {
+        if (scheduler->admit_request()) {
+            return *scheduler;
+        }
+    }
+
+    const LlamaCppScheduler& shared = *m_schedulers.front();
+    OPENVINO_ASSERT(m_kv_cache_size == 0 && m_num_requests == 0,
+                    "llama_cpp_plugin: the KV cache is taken by ",
+                    shared.get_max_requests(),
+                    " infer requests with a context of ",
+                    shared.get_n_ctx_per_request(),
+                    " tokens each, set LLAMA_CPP_KV_CACHE_SIZE to at least ",
+                    (shared.get_max_requests() + 1) * shared.get_n_ctx_per_request(),
+                    " or a larger PERFORMANCE_HINT_NUM_REQUESTS at compile_model to run more infer requests at once");
+
+    // The capacity is not given, so every other request gets a context of the train-time size of its own, as it did
+    // before the KV cache was shared
+    m_schedulers.emplace_back(new LlamaCppScheduler(m_llama_model_ptr, m_num_threads, 0, 1));
+    m_schedulers.back()->admit_request();
+    return *m_schedulers.back();
+}
+
 std::shared_ptr<ov::ISyncInferRequest> LlamaCppModel::create_sync_infer_request() const {
-    return std::make_shared<LlamaCppSyncInferRequest>(std::static_pointer_cast<const LlamaCppModel>(shared_from_this()),
-                                                      m_num_threads);
+    return std::make_shared<LlamaCppSyncInferRequest>(
+        std::static_pointer_cast<const LlamaCppModel>(shared_from_this()));
 }
 
 const std::vector<ov::Output<const ov::Node>>& LlamaCppModel::inputs() const {
@@ -5,7 +5,6 @@
 
 #include <memory>
 #include <openvino/runtime/ivariable_state.hpp>
-#include <thread>
 
 #include "llama.h"
 #include "openvino/runtime/make_tensor.hpp"
@@ -25,14 +24,9 @@ void allocate_tensor_impl(ov::SoPtr<ov::ITensor>& tensor,
     }
 }
 
-LlamaCppSyncInferRequest::LlamaCppSyncInferRequest(const std::shared_ptr<const LlamaCppModel>& compiled_model,
-                                                   size_t num_threads)
+LlamaCppSyncInferRequest::LlamaCppSyncInferRequest(const std::shared_ptr<const LlamaCppModel>& compiled_model)
     : ov::ISyncInferRequest(compiled_model) {
     OPENVINO_DEBUG << "llama_cpp_plugin: infer request ctor called\n";
-    llama_context_params cparams = llama_context_default_params();
-    cparams.n_threads = num_threads ? num_threads : std::thread::hardware_concurrency();
-    cparams.n_ctx = 0;  // this means that the actual n_ctx will be taken equal to the model's train-time value
-    m_llama_ctx = llama_new_context_with_model(compiled_model->m_llama_model_ptr, cparams);
     m_compiled_model_ptr = compiled_model;
     for (const auto& input : get_inputs()) {
         allocate_tensor(input, [input](ov::SoPtr<ov::ITensor>& tensor) {
@@ -54,22 +48,6 @@ void LlamaCppSyncInferRequest::set_tensors_impl(const ov::Output<const ov::Node>
     OPENVINO_DEBUG << "llama_cpp_plugin: set_tensors_impl called\n";
 }
 
-void llama_batch_add_reimpl(struct llama_batch& batch,
-                            llama_token id,
-                            llama_pos pos,
-                            const std::vector<llama_seq_id>& seq_ids,
-                            bool logits) {
-    batch.token[batch.n_tokens] = id;
-    batch.pos[batch.n_tokens] = pos;
-    batch.n_seq_id[batch.n_tokens] = seq_ids.size();
-    for (size_t i = 0; i < seq_ids.size(); ++i) {
-        batch.seq_id[batch.n_tokens][i] = seq_ids[i];
-    }
-    batch.logits[batch.n_tokens] = logits;
-
-    batch.n_tokens++;
-}
-
 void LlamaCppSyncInferRequest::infer() {
     auto input_ids_tensor_ptr = get_tensor(get_inputs()[0]);     // TODO (vshampor) correctly identify input_ids among
                                                                  // all inputs without hardcode
@@ -81,54 +59,36 @@ void LlamaCppSyncInferRequest::infer() {
     size_t batch_size = input_ids_tensor_ptr->get_shape()[0];
     size_t sequence_length = input_ids_tensor_ptr->get_shape()[1];
 
-    llama_batch batch = llama_batch_init(sequence_length * batch_size, /* embd = */ 0, /* n_seq_max = */ batch_size);
-    const int64_t* data_ptr = input_ids_tensor_ptr->data<int64_t>();
-
-    const int64_t* sequence_start_ptr = data_ptr /* + seq_idx */;
-
-    const int64_t* position_idx_ptr = position_ids_tensor_ptr->data<int64_t>();
-
-    int num_sequences = batch_size;
-
-    for (int seq_idx = 0; seq_idx < num_sequences; seq_idx++) {
-        for (size_t tok_idx = 0; tok_idx < sequence_length; ++tok_idx) {
-            const int64_t token_id = sequence_start_ptr[seq_idx * sequence_length + tok_idx];
-            const int64_t position_id = position_idx_ptr[seq_idx * sequence_length + tok_idx];
-            llama_batch_add_reimpl(batch,
-                                   token_id,
-                                   position_id,
-                                   {seq_idx},
-                                   true);  // the last `true` here is a marker that the logits for this
-                                           // token should be computed and returned
-        }
-    }
-
-    int32_t sts = llama_decode(m_llama_ctx, batch);
-
-    if (sts != 0) {
-        OPENVINO_THROW("llama_decode failed with code ", sts);
+    if (m_sequences->scheduler == nullptr) {
+        // The request takes room in a KV cache on its first step and keeps it until it is destroyed
+        m_sequences->scheduler = &m_compiled_model_ptr->admit_request();
     }
+    LlamaCppScheduler& scheduler = *m_sequences->scheduler;
+    // Every batch element is a separate sequence in the shared KV cache, new ones start with an empty history
+    scheduler.acquire_sequences(m_sequences->seq_ids, batch_size);
 
-    size_t n_vocab = llama_n_vocab(m_compiled_model_ptr->m_llama_model_ptr);
-
-    ov::Tensor output_tensor{ov::element::Type_t::f32, {batch_size, sequence_length, n_vocab}};
-    float* output_tensor_data_ptr = output_tensor.data<float>();
-
-    for (size_t batch_idx = 0; batch_idx < batch_size; batch_idx++) {
-        for (size_t seq_idx = 0; seq_idx < sequence_length; seq_idx++) {
-            size_t pos = batch_idx * sequence_length + seq_idx;
-            float* logits_from_llama = llama_get_logits_ith(m_llama_ctx, pos);
-            std::copy(logits_from_llama, logits_from_llama + n_vocab, output_tensor_data_ptr + pos * n_vocab);
-        }
-    }
+    // With last_token_logits_only only the last position of each sequence gets the logits
+    const bool last_logits_only = m_compiled_model_ptr->m_last_token_logits_only.load();
+    const size_t output_length = last_logits_only ? 1 : sequence_length;
 
+    // The logits are written to the output port tensor directly, which keeps its memory if it does not grow
     auto& logit_output = get_outputs()[0];
-    allocate_tensor(logit_output, [&output_tensor](ov::SoPtr<ov::ITensor>& tensor) {
-        allocate_tensor_impl(tensor, output_tensor.get_element_type(), output_tensor.get_shape());
-        output_tensor.copy_to(ov::make_tensor(tensor));
+    const ov::Shape logits_shape{batch_size, output_length, scheduler.get_n_vocab()};
+    allocate_tensor(logit_output, [&logits_shape](ov::SoPtr<ov::ITensor>& tensor) {
+        allocate_tensor_impl(tensor, ov::element::Type_t::f32, logits_shape);
     });
 
-    llama_batch_free(batch);
+    LlamaCppScheduler::DecodeStep step;
+    step.token_ids = input_ids_tensor_ptr->data<int64_t>();
+    step.position_ids = position_ids_tensor_ptr->data<int64_t>();
+    step.seq_ids = m_sequences->seq_ids.data();
+    step.n_sequences = batch_size;
+    step.sequence_length = sequence_length;
+    step.last_token_logits_only = last_logits_only;
+    step.logits = get_tensor(logit_output)->data<float>();
+
+    // Blocks until the step is decoded, possibly in the same llama_decode call as the steps of other requests
+    scheduler.decode(step);
 };
 std::vector<ov::ProfilingInfo> LlamaCppSyncInferRequest::get_profiling_info() const {
     OPENVINO_DEBUG << "llama_cpp_plugin: get_profiling_info() called\n";
@@ -137,13 +97,17 @@ std::vector<ov::ProfilingInfo> LlamaCppSyncInferRequest::get_profiling_info() co
 
 std::vector<ov::SoPtr<ov::IVariableState>> LlamaCppSyncInferRequest::query_state() const {
     OPENVINO_DEBUG << "llama_cpp_plugin: query_state() called\n";
-    return {std::static_pointer_cast<ov::IVariableState>(std::make_shared<LlamaCppState>(m_llama_ctx))};
+    return {std::static_pointer_cast<ov::IVariableState>(
+        std::make_shared<LlamaCppState>(m_compiled_model_ptr, m_sequences))};
 }
 
 LlamaCppSyncInferRequest::~LlamaCppSyncInferRequest() {
-    if (m_llama_ctx != nullptr) {
-        llama_free(m_llama_ctx);
+    if (m_sequences->scheduler != nullptr) {
+        m_sequences->scheduler->release_request(m_sequences->seq_ids);
     }
+    // the states outliving the request must not reset the sequences handed to other requests
+    m_sequences->scheduler = nullptr;
+    m_sequences->seq_ids.clear();
 }
 }  // namespace llama_cpp_plugin
 }  // namespace ov
@@ -9,10 +9,10 @@
 #include "openvino/op/constant.hpp"
 #include "openvino/runtime/internal_properties.hpp"
 #include "openvino/util/log.hpp"
+#include "properties.hpp"
 
 namespace {
 static constexpr const char* wait_executor_name = "LlamaCppWaitExecutor";
-static constexpr const char* stream_executor_name = "LlamaCppStreamsExecutor";
 static constexpr const char* template_exclusive_executor = "LlamaCppExecutor";
 }  // namespace
 
@@ -43,7 +43,27 @@ std::shared_ptr<ov::ICompiledModel> LlamaCppPlugin::compile_model(const std::str
     } else {
         num_threads = m_num_threads;
     }
-    return std::make_shared<LlamaCppModel>(fname, shared_from_this(), num_threads);
+    bool last_logits_only = false;
+    it = properties.find(last_token_logits_only.name());
+    if (it != properties.end()) {
+        last_logits_only = it->second.as<bool>();
+    }
+    uint32_t kv_cache_tokens = 0;
+    it = properties.find(kv_cache_size.name());
+    if (it != properties.end()) {
+        kv_cache_tokens = it->second.as<uint32_t>();
+    }
+    uint32_t num_requests = 0;
+    it = properties.find(ov::hint::num_requests.name());
+    if (it != properties.end()) {
+        num_requests = it->second.as<uint32_t>();
+    }
+    return std::make_shared<LlamaCppModel>(fname,
+                                           shared_from_this(),
+                                           num_threads,
+                                           last_logits_only,
+                                           kv_cache_tokens,
+                                           num_requests);
 }
 
 void LlamaCppPlugin::set_property(const ov::AnyMap& properties) {
@@ -0,0 +1,210 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "openvino/core/except.hpp"
+#include "openvino/util/log.hpp"
+
+namespace ov {
+namespace llama_cpp_plugin {
+
+LlamaCppScheduler::LlamaCppScheduler(llama_model* model,
+                                     size_t num_threads,
+                                     uint32_t kv_cache_size,
+                                     uint32_t num_requests) {
+    // Every infer request used to have a llama_context of the train-time size of its own, the shared KV cache keeps
+    // that much room for each of the requests it admits
+    const uint32_t n_ctx_train = static_cast<uint32_t>(llama_n_ctx_train(model));
+    if (kv_cache_size == 0) {
+        kv_cache_size = n_ctx_train * (num_requests ? num_requests : 1);
+    }
+
+    llama_context_params cparams = llama_context_default_params();
+    cparams.n_threads = num_threads ? num_threads : std::thread::hardware_concurrency();
+    cparams.n_ctx = kv_cache_size;
+    m_llama_ctx = llama_new_context_with_model(model, cparams);
+    OPENVINO_ASSERT(m_llama_ctx != nullptr, "llama_cpp_plugin: failed to create llama context");
+
+    const size_t n_ctx = llama_n_ctx(m_llama_ctx);
+    m_n_ctx_per_request = std::min<size_t>(n_ctx_train, n_ctx);
+    m_max_requests = n_ctx / m_n_ctx_per_request;
+
+    m_n_vocab = llama_n_vocab(model);
+    m_n_batch = cparams.n_batch;
+    // every token belongs to a single sequence, see decode_steps
+    m_batch = llama_batch_init(m_n_batch, /* embd = */ 0, /* n_seq_max = */ 1);
+    m_batch_logits.resize(m_n_batch);
+}
+
+LlamaCppScheduler::~LlamaCppScheduler() {
+    llama_batch_free(m_batch);
+    llama_free(m_llama_ctx);
+}
+
+bool LlamaCppScheduler::admit_request() {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    if (m_n_requests == m_max_requests) {
+        return false;
+    }
+    m_n_requests++;
+    return true;
+}
+
+void LlamaCppScheduler::acquire_sequences(std::vector<llama_seq_id>& seq_ids, size_t n_sequences) {
+    if (seq_ids.size() >= n_sequences) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    while (seq_ids.size() < n_sequences) {
+        if (m_free_seq_ids.empty()) {
+            seq_ids.push_back(m_next_seq_id++);
+        } else {
+            seq_ids.push_back(m_free_seq_ids.back());
+            m_free_seq_ids.pop_back();
+        }
+    }
+}
+
+void LlamaCppScheduler::release_request(const std::vector<llama_seq_id>& seq_ids) {
+    for (llama_seq_id seq_id : seq_ids) {
+        clear_sequence(seq_id);
+    }
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    m_free_seq_ids.insert(m_free_seq_ids.end(), seq_ids.begin(), seq_ids.end());
+    m_n_requests--;
+}
+
+void LlamaCppScheduler::clear_sequence(llama_seq_id seq_id) {
+    std::lock_guard<std::mutex> lock(m_context_mutex);
+    llama_kv_cache_seq_rm(m_llama_ctx, seq_id, -1, -1);
+}
+
+void LlamaCppScheduler::decode(const DecodeStep& step) {
+    PendingStep pending;
+    pending.step = &step;
+
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_queue.push_back(&pending);
+    while (!pending.done) {
+        if (m_decoding) {
+            m_queue_cv.wait(lock);
+            continue;
+        }
+
+        // The context is idle, so this thread decodes all the steps queued so far, its own one included.
+        // The steps submitted meanwhile are queued and decoded together by one of their threads afterwards.
+        m_decoding = true;
+        std::vector<PendingStep*> steps;
+        steps.swap(m_queue);
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> context_lock(m_context_mutex);
+            try {
+                decode_steps(steps);
+            } catch (...) {
+                // The chunks flushed before the failing llama_decode are already in the KV cache, so the tokens of
+                // all the steps are removed and the steps are decoded again one by one. Only the steps failing on
+                // their own get the error and keep the history they had before.
+                for (auto* failed : steps) {
+                    remove_step_tokens(*failed->step);
+                }
+                if (steps.size() == 1) {
+                    steps[0]->error = std::current_exception();
+                } else {
+                    for (auto* retried : steps) {
+                        try {
+                            decode_steps({retried});
+                        } catch (...) {
+                            retried->error = std::current_exception();
+                            remove_step_tokens(*retried->step);
+                        }
+                    }
+                }
+            }
+        }
+
+        lock.lock();
+        for (auto* decoded : steps) {
+            decoded->done = true;
+        }
+        m_decoding = false;
+        m_queue_cv.notify_all();
+    }
+    lock.unlock();
+
+    if (pending.error) {
+        std::rethrow_exception(pending.error);
+    }
+}
+
+void LlamaCppScheduler::decode_steps(const std::vector<PendingStep*>& steps) {
+    OPENVINO_DEBUG << "llama_cpp_plugin: decoding " << steps.size() << " steps\n";
+    m_batch.n_tokens = 0;
+    for (const auto* pending : steps) {
+        const DecodeStep& step = *pending->step;
+        const size_t output_length = step.last_token_logits_only ? 1 : step.sequence_length;
+        const size_t first_output = step.sequence_length - output_length;
+        for (size_t seq_idx = 0; seq_idx < step.n_sequences; seq_idx++) {
+            for (size_t tok_idx = 0; tok_idx < step.sequence_length; tok_idx++) {
+                const size_t pos = seq_idx * step.sequence_length + tok_idx;
+                const bool need_logits = tok_idx >= first_output;
+
+                const int32_t i = m_batch.n_tokens;
+                m_batch.token[i] = static_cast<llama_token>(step.token_ids[pos]);
+                m_batch.pos[i] = static_cast<llama_pos>(step.position_ids[pos]);
+                m_batch.n_seq_id[i] = 1;
+                m_batch.seq_id[i][0] = step.seq_ids[seq_idx];
+                m_batch.logits[i] = need_logits;
+                m_batch_logits[i] = nullptr;
+                if (need_logits) {
+                    m_batch_logits[i] = step.logits + (seq_idx * output_length + tok_idx - first_output) * m_n_vocab;
+                }
+                m_batch.n_tokens++;
+
+                // Long prompts are split into several llama_decode calls, the sequence is causal so the tokens
+                // of the next call attend to the KV cache of the previous ones
+                if (static_cast<size_t>(m_batch.n_tokens) == m_n_batch) {
+                    flush_batch();
+                }
+            }
+        }
+    }
+    if (m_batch.n_tokens > 0) {
+        flush_batch();
+    }
+}
+
+void LlamaCppScheduler::remove_step_tokens(const DecodeStep& step) {
+    if (step.sequence_length == 0) {
+        return;
+    }
+    for (size_t seq_idx = 0; seq_idx < step.n_sequences; seq_idx++) {
+        const int64_t* positions = step.position_ids + seq_idx * step.sequence_length;
+        const int64_t first_pos = *std::min_element(positions, positions + step.sequence_length);
+        llama_kv_cache_seq_rm(m_llama_ctx, step.seq_ids[seq_idx], static_cast<llama_pos>(first_pos), -1);
+    }
+}
+
+void LlamaCppScheduler::flush_batch() {
+    int32_t sts = llama_decode(m_llama_ctx, m_batch);
+    if (sts != 0) {
+        OPENVINO_THROW("llama_decode failed with code ", sts);
+    }
+
+    for (int32_t i = 0; i < m_batch.n_tokens; i++) {
+        if (m_batch_logits[i] != nullptr) {
+            // llama_get_logits_ith takes the index of the token in the llama batch
+            const float* logits_from_llama = llama_get_logits_ith(m_llama_ctx, i);
+            std::copy(logits_from_llama, logits_from_llama + m_n_vocab, m_batch_logits[i]);
+        }
+    }
+    m_batch.n_tokens = 0;
+}
+
+}  // namespace llama_cpp_plugin
+}  // namespace ov
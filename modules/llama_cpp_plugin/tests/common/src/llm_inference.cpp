@@ -23,8 +23,10 @@ std::vector<float> infer_and_get_last_logits(ov::InferRequest& infer_request,
                                              const std::vector<int64_t>& tokens,
                                              int64_t position_ids_start_value) {
     infer_request = infer_logits_for_tokens_with_positions(infer_request, tokens, position_ids_start_value);
-    size_t vocab_size = infer_request.get_tensor("logits").get_shape().back();
-    float* logits = infer_request.get_tensor("logits").data<float>() + (tokens.size() - 1) * vocab_size;
+    // the logits may have been requested for the last position only, so the offset follows the output shape
+    ov::Shape logits_shape = infer_request.get_tensor("logits").get_shape();
+    size_t vocab_size = logits_shape.back();
+    float* logits = infer_request.get_tensor("logits").data<float>() + (logits_shape[1] - 1) * vocab_size;
     std::vector<float> logits_vector(vocab_size);
     std::copy(logits, logits + vocab_size, logits_vector.begin());
     return logits_vector;
@@ -31,6 +31,26 @@ INSTANTIATE_TEST_SUITE_P(VariousBatchAndInputShapes,
                          LlamaCppBatchingDimensionTest,
                          ::testing::Values(ov::Shape{2, 1}, ov::Shape{3, 12}, ov::Shape{13, 7}));
 
+TEST(LlamaCppBatchingTest, OutputDimensionFollowsInputDimensionWithinSameInferRequest) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP");
+    auto infer_request = model.create_infer_request();
+
+    // the llama.cpp batch and the output tensor of the request are reused, growing and shrinking the input
+    // must still produce the logits of the current shape
+    for (const auto& batched_shape : {ov::Shape{2, 1}, ov::Shape{13, 7}, ov::Shape{3, 12}, ov::Shape{1, 1}}) {
+        infer_request.reset_state();
+        auto input_tensor = ov::Tensor(ov::element::Type_t::i64, batched_shape);
+        std::fill(input_tensor.data<int64_t>(), input_tensor.data<int64_t>() + input_tensor.get_size(), 0);
+        infer_request.set_tensor("input_ids", input_tensor);
+        infer_request.set_tensor("position_ids", input_tensor);
+        infer_request.infer();
+        auto output_shape = infer_request.get_tensor("logits").get_shape();
+        ASSERT_EQ(output_shape.size(), 3);
+        ASSERT_EQ(batched_shape, (ov::Shape{output_shape[0], output_shape[1]}));
+    }
+}
+
 TEST(LlamaCppBatchingTest, BatchedResultIsIdenticalToSingleBatchResults) {
     ov::Core core;
     auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP");
@@ -0,0 +1,184 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>
+
+#include "llm_inference.hpp"
+#include "properties.hpp"
+
+const std::string MODEL_FILE = ov::test::utils::getCurrentWorkingDir() + SEP + TEST_FILES_DIR + SEP + "gpt2.gguf";
+
+// "Why is the Sun yellow?", "Who is John Lennon?" and their prefixes
+const std::vector<std::vector<int64_t>> GPT2_PROMPTS_TOKEN_IDS = {{5195, 318, 262, 3825, 7872, 30},
+                                                                 {8241, 318, 1757, 37470, 30},
+                                                                 {5195, 318, 262},
+                                                                 {8241, 318}};
+
+constexpr size_t NUM_TOKENS_TO_GENERATE = 16;
+constexpr size_t GPT2_CONTEXT_LENGTH = 1024;
+
+std::vector<int64_t> generate_for_prompt(ov::InferRequest& infer_request, const std::vector<int64_t>& prompt) {
+    std::vector<float> logits = infer_and_get_last_logits(infer_request, prompt, 0);
+    return generate_n_tokens_with_positions(infer_request,
+                                            get_token_from_logits(logits),
+                                            NUM_TOKENS_TO_GENERATE,
+                                            prompt.size());
+}
+
+TEST(LlamaCppContinuousBatchingTest, ConcurrentRequestsGenerateSameTokensAsSequentialOnes) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP", ov::hint::num_requests(GPT2_PROMPTS_TOKEN_IDS.size()));
+
+    std::vector<std::vector<int64_t>> ref_token_ids;
+    for (const auto& prompt : GPT2_PROMPTS_TOKEN_IDS) {
+        auto infer_request = model.create_infer_request();
+        ref_token_ids.push_back(generate_for_prompt(infer_request, prompt));
+    }
+
+    // the requests share the KV cache of the model and their decode steps are merged into common llama.cpp batches
+    std::vector<ov::InferRequest> infer_requests;
+    for (size_t i = 0; i < GPT2_PROMPTS_TOKEN_IDS.size(); i++) {
+        infer_requests.push_back(model.create_infer_request());
+    }
+    std::vector<std::vector<int64_t>> token_ids(GPT2_PROMPTS_TOKEN_IDS.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < GPT2_PROMPTS_TOKEN_IDS.size(); i++) {
+        threads.emplace_back([&, i]() {
+            token_ids[i] = generate_for_prompt(infer_requests[i], GPT2_PROMPTS_TOKEN_IDS[i]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(token_ids, ref_token_ids);
+}
+
+TEST(LlamaCppContinuousBatchingTest, AsyncRequestsGenerateSameTokensAsSequentialOnes) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP", ov::hint::num_requests(GPT2_PROMPTS_TOKEN_IDS.size()));
+
+    std::vector<std::vector<int64_t>> ref_token_ids;
+    for (const auto& prompt : GPT2_PROMPTS_TOKEN_IDS) {
+        auto infer_request = model.create_infer_request();
+        ref_token_ids.push_back(generate_for_prompt(infer_request, prompt));
+    }
+
+    // the streams of the model run infer() of all the started requests at once, so their steps are batched
+    std::vector<ov::InferRequest> infer_requests;
+    std::vector<std::vector<int64_t>> token_ids(GPT2_PROMPTS_TOKEN_IDS.size());
+    std::vector<int64_t> positions;
+    for (size_t i = 0; i < GPT2_PROMPTS_TOKEN_IDS.size(); i++) {
+        infer_requests.push_back(model.create_infer_request());
+        token_ids[i] = GPT2_PROMPTS_TOKEN_IDS[i];
+        positions.push_back(0);
+    }
+    for (size_t step = 0; step <= NUM_TOKENS_TO_GENERATE; step++) {
+        for (size_t i = 0; i < infer_requests.size(); i++) {
+            // the whole prompt first, then the last generated token
+            const std::vector<int64_t> tokens(token_ids[i].begin() + positions[i], token_ids[i].end());
+            auto input_ids_tensor = ov::Tensor(ov::element::Type_t::i64, {1, tokens.size()});
+            std::copy(tokens.begin(), tokens.end(), input_ids_tensor.data<int64_t>());
+            infer_requests[i].set_tensor("input_ids", input_ids_tensor);
+            ov::Tensor position_ids = infer_requests[i].get_tensor("position_ids");
+            position_ids.set_shape(input_ids_tensor.get_shape());
+            std::iota(position_ids.data<int64_t>(), position_ids.data<int64_t>() + tokens.size(), positions[i]);
+            CompiledModelTest::fill_unused_inputs(infer_requests[i], input_ids_tensor.get_shape());
+            infer_requests[i].start_async();
+        }
+        for (size_t i = 0; i < infer_requests.size(); i++) {
+            infer_requests[i].wait();
+            ov::Tensor logits = infer_requests[i].get_tensor("logits");
+            const size_t vocab_size = logits.get_shape().back();
+            const float* last = logits.data<float>() + (logits.get_size() - vocab_size);
+            positions[i] = token_ids[i].size();
+            token_ids[i].push_back(std::max_element(last, last + vocab_size) - last);
+        }
+    }
+
+    for (size_t i = 0; i < infer_requests.size(); i++) {
+        const std::vector<int64_t> generated(token_ids[i].begin() + GPT2_PROMPTS_TOKEN_IDS[i].size(),
+                                             token_ids[i].end());
+        EXPECT_EQ(generated, ref_token_ids[i]);
+    }
+}
+
+TEST(LlamaCppContinuousBatchingTest, ResetStateDoesNotAffectOtherRequests) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP", ov::hint::num_requests(3));
+
+    auto ref_infer_request = model.create_infer_request();
+    std::vector<int64_t> ref_token_ids = generate_for_prompt(ref_infer_request, GPT2_PROMPTS_TOKEN_IDS[0]);
+    ref_infer_request.reset_state();
+
+    auto infer_request = model.create_infer_request();
+    auto other_infer_request = model.create_infer_request();
+    std::vector<float> logits = infer_and_get_last_logits(infer_request, GPT2_PROMPTS_TOKEN_IDS[0], 0);
+    infer_and_get_last_logits(other_infer_request, GPT2_PROMPTS_TOKEN_IDS[1], 0);
+    other_infer_request.reset_state();
+
+    std::vector<int64_t> token_ids = generate_n_tokens_with_positions(infer_request,
+                                                                      get_token_from_logits(logits),
+                                                                      NUM_TOKENS_TO_GENERATE,
+                                                                      GPT2_PROMPTS_TOKEN_IDS[0].size());
+    EXPECT_EQ(token_ids, ref_token_ids);
+}
+
+TEST(LlamaCppContinuousBatchingTest, DefaultKvCacheHasRoomForOneRequest) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP");
+    ASSERT_EQ(model.get_property(ov::optimal_number_of_infer_requests), 1);
+
+    std::vector<int64_t> long_prompt;
+    while (long_prompt.size() < GPT2_CONTEXT_LENGTH) {
+        long_prompt.insert(long_prompt.end(), GPT2_PROMPTS_TOKEN_IDS[0].begin(), GPT2_PROMPTS_TOKEN_IDS[0].end());
+    }
+    long_prompt.resize(GPT2_CONTEXT_LENGTH);
+
+    // the requests beyond the first one get contexts of their own, so all of them can take the whole context
+    std::vector<ov::InferRequest> infer_requests;
+    std::vector<int64_t> token_ids;
+    for (size_t i = 0; i < 3; i++) {
+        infer_requests.push_back(model.create_infer_request());
+        token_ids.push_back(get_token_from_logits(infer_and_get_last_logits(infer_requests.back(), long_prompt, 0)));
+    }
+    EXPECT_EQ(token_ids, std::vector<int64_t>(3, token_ids[0]));
+}
+
+TEST(LlamaCppContinuousBatchingTest, KvCacheIsFilledFromTwoRequests) {
+    ov::Core core;
+    // room for two contexts of the model
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP", ov::hint::num_requests(2));
+    ASSERT_EQ(model.get_property(ov::optimal_number_of_infer_requests), 2);
+
+    std::vector<int64_t> long_prompt;
+    while (long_prompt.size() < GPT2_CONTEXT_LENGTH) {
+        long_prompt.insert(long_prompt.end(), GPT2_PROMPTS_TOKEN_IDS[0].begin(), GPT2_PROMPTS_TOKEN_IDS[0].end());
+    }
+    long_prompt.resize(GPT2_CONTEXT_LENGTH);
+
+    // both requests take the whole context of the model
+    auto infer_request = model.create_infer_request();
+    auto other_infer_request = model.create_infer_request();
+    std::vector<float> logits = infer_and_get_last_logits(infer_request, long_prompt, 0);
+    std::vector<float> other_logits = infer_and_get_last_logits(other_infer_request, long_prompt, 0);
+    EXPECT_EQ(get_token_from_logits(logits), get_token_from_logits(other_logits));
+
+    // a third request does not fit and says which property to increase
+    auto third_infer_request = model.create_infer_request();
+    try {
+        infer_and_get_last_logits(third_infer_request, GPT2_PROMPTS_TOKEN_IDS[0], 0);
+        FAIL() << "the third infer request is expected to be rejected";
+    } catch (const ov::Exception& ex) {
+        EXPECT_NE(std::string(ex.what()).find(ov::llama_cpp_plugin::kv_cache_size.name()), std::string::npos);
+    }
+
+    // the same with the size given in tokens
+    auto sized_model = core.compile_model(MODEL_FILE,
+                                          "LLAMA_CPP",
+                                          ov::llama_cpp_plugin::kv_cache_size(2 * GPT2_CONTEXT_LENGTH));
+    ASSERT_EQ(sized_model.get_property(ov::optimal_number_of_infer_requests), 2);
+}
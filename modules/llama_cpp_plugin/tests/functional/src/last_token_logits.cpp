@@ -0,0 +1,42 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include "llm_inference.hpp"
+#include "properties.hpp"
+
+const std::string MODEL_FILE = ov::test::utils::getCurrentWorkingDir() + SEP + TEST_FILES_DIR + SEP + "gpt2.gguf";
+
+const std::vector<int64_t> GPT2_SUN_PROMPT_TOKEN_IDS = {5195, 318, 262, 3825, 7872, 30};
+
+TEST(LlamaCppLastTokenLogitsTest, OutputHasSinglePositionPerSequence) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP", ov::llama_cpp_plugin::last_token_logits_only(true));
+    ASSERT_TRUE(model.get_property(ov::llama_cpp_plugin::last_token_logits_only));
+    auto infer_request = model.create_infer_request();
+
+    auto input_tensor = ov::Tensor(ov::element::Type_t::i64, ov::Shape{3, 12});
+    std::fill(input_tensor.data<int64_t>(), input_tensor.data<int64_t>() + input_tensor.get_size(), 0);
+    infer_request.set_tensor("input_ids", input_tensor);
+    infer_request.set_tensor("position_ids", input_tensor);
+    infer_request.infer();
+    auto output_shape = infer_request.get_tensor("logits").get_shape();
+    ASSERT_EQ(output_shape.size(), 3);
+    ASSERT_EQ(output_shape[0], 3);
+    ASSERT_EQ(output_shape[1], 1);
+}
+
+TEST(LlamaCppLastTokenLogitsTest, LastTokenLogitsAreIdenticalToFullLogits) {
+    ov::Core core;
+    auto model = core.compile_model(MODEL_FILE, "LLAMA_CPP");
+    auto infer_request = model.create_infer_request();
+    std::vector<float> ref_logits = infer_and_get_last_logits(infer_request, GPT2_SUN_PROMPT_TOKEN_IDS, 0);
+
+    model.set_property(ov::llama_cpp_plugin::last_token_logits_only(true));
+    auto last_only_infer_request = model.create_infer_request();
+    std::vector<float> last_logits = infer_and_get_last_logits(last_only_infer_request, GPT2_SUN_PROMPT_TOKEN_IDS, 0);
+    ASSERT_EQ(last_only_infer_request.get_tensor("logits").get_shape()[1], 1);
+
+    EXPECT_EQ(ref_logits, last_logits);
+}
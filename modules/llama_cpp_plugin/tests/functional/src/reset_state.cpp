@@ -1,6 +1,8 @@
 // Copyright (C) 2024 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <numeric>
+
 #include "llm_inference.hpp"
 #include "model_fixture.hpp"
 #include "openvino/runtime/infer_request.hpp"
@@ -94,3 +96,43 @@ TEST_F(CompiledModelTest, StatesForDifferentInferRequestsAreIndependentGPT2) {
 
     EXPECT_NE(out_tokens_another, out_tokens_first);
 }
+
+TEST_F(CompiledModelTest, StateQueriedBeforeInferResetsSequencesAddedLaterGPT2) {
+    ov::InferRequest ref_lm = model.create_infer_request();
+    int64_t ref_token = get_token_from_logits(infer_and_get_last_logits(ref_lm, GPT2_SUN_PROMPT_TOKEN_IDS, 0));
+
+    // the state is queried before the request has any sequences, the two batch rows acquire them afterwards
+    ov::InferRequest lm = model.create_infer_request();
+    std::vector<ov::VariableState> states = lm.query_state();
+
+    auto infer_batch_of_two = [&lm](const std::vector<int64_t>& tokens) -> std::vector<int64_t> {
+        auto input_ids_tensor = ov::Tensor(ov::element::Type_t::i64, {2, tokens.size()});
+        auto position_ids_tensor = ov::Tensor(ov::element::Type_t::i64, {2, tokens.size()});
+        for (size_t row = 0; row < 2; row++) {
+            std::copy(tokens.begin(), tokens.end(), input_ids_tensor.data<int64_t>() + row * tokens.size());
+            std::iota(position_ids_tensor.data<int64_t>() + row * tokens.size(),
+                      position_ids_tensor.data<int64_t>() + (row + 1) * tokens.size(),
+                      0);
+        }
+        lm.set_tensor("input_ids", input_ids_tensor);
+        lm.set_tensor("position_ids", position_ids_tensor);
+        CompiledModelTest::fill_unused_inputs(lm, input_ids_tensor.get_shape());
+        lm.infer();
+
+        ov::Tensor logits = lm.get_tensor("logits");
+        const size_t output_length = logits.get_shape()[1];
+        const size_t vocab_size = logits.get_shape()[2];
+        std::vector<int64_t> last_tokens;
+        for (size_t row = 0; row < 2; row++) {
+            const float* last = logits.data<float>() + ((row + 1) * output_length - 1) * vocab_size;
+            last_tokens.push_back(std::max_element(last, last + vocab_size) - last);
+        }
+        return last_tokens;
+    };
+
+    infer_batch_of_two(GPT2_LENNON_PROMPT_TOKEN_IDS);
+    for (auto& state : states) {
+        state.reset();
+    }
+    EXPECT_EQ(infer_batch_of_two(GPT2_SUN_PROMPT_TOKEN_IDS), std::vector<int64_t>(2, ref_token));
+}
@@ -21,7 +21,8 @@ def mps_gather_workaround(input, dim, index):
 
 
 def bipartite_soft_matching_random2d(metric: torch.Tensor,
-                                     r: int) -> Tuple[Callable, Callable]:
+                                     r: int,
+                                     native_unmerge: bool = False) -> Tuple[Callable, Callable]:
     """
     Partitions the tokens into src and dst and merges r tokens from src to dst.
     Dst tokens are partitioned by choosing one randomy in each (sx, sy) region.
@@ -29,6 +30,7 @@ def bipartite_soft_matching_random2d(metric: torch.Tensor,
     Args:
      - metric [B, N, C]: metric to use for similarity
      - r: number of tokens to remove (by merging)
+     - native_unmerge: export unmerge as a single ToMeUnmerge operation of the OpenVINO custom operations extension
     """
     if r <= 0:
         return do_nothing, do_nothing
@@ -60,7 +62,10 @@ def bipartite_soft_matching_random2d(metric: torch.Tensor,
 
         return dst
 
-    def unmerge(x: torch.Tensor) -> torch.Tensor:
+    def unmerge(x: torch.Tensor, residual: torch.Tensor = None) -> torch.Tensor:
+        if native_unmerge:
+            return ToMeUnmerge.apply(x, rand_idx, dst_idx, residual)
+
         C = x.shape[-1]
         dst = x
         src = dst.gather(dim=-2, index=dst_idx.expand(B, r, C))
@@ -70,7 +75,7 @@ def bipartite_soft_matching_random2d(metric: torch.Tensor,
         out.scatter_(dim=-2, index=a_idx.expand(B, r, C), src=src)
         out.scatter_(dim=-2, index=b_idx.expand(B, N - r, C), src=dst)
 
-        return out
+        return out if residual is None else out + residual
         
     return merge, unmerge
 
@@ -183,3 +188,63 @@ def merge_source(
 
     source = merge(source, mode="amax")
     return source
+
+
+class ToMeMerge(torch.autograd.Function):
+    """
+    bipartite_soft_matching followed by merge_wavg, exported to ONNX as a single ToMeMerge operation.
+    The operation is implemented by the OpenVINO custom operations extension (modules/custom_operations),
+    which has to be added to the OpenVINO Core reading the exported model.
+    """
+
+    @staticmethod
+    def symbolic(g, x, metric, size, r, class_token, distill_token):
+        return g.op("ToMeMerge", x, metric, size, r_i=r, class_token_i=int(class_token),
+                    distill_token_i=int(distill_token), outputs=2)
+
+    @staticmethod
+    def forward(ctx, x, metric, size, r, class_token, distill_token):
+        merge, _ = bipartite_soft_matching(metric, r, class_token, distill_token)
+        return merge_wavg(merge, x, size)
+
+
+def merge_wavg_native(
+    metric: torch.Tensor,
+    x: torch.Tensor,
+    r: int,
+    class_token: bool = False,
+    distill_token: bool = False,
+    size: torch.Tensor = None,
+) -> Tuple[torch.Tensor, torch.Tensor]:
+    """
+    Same as merge_wavg of the bipartite_soft_matching merge, but as a single ToMeMerge operation.
+    Returns the merged tensor and the new token sizes.
+    """
+    if size is None:
+        size = torch.ones_like(x[..., 0, None])
+
+    return ToMeMerge.apply(x, metric, size, r, class_token, distill_token)
+
+
+class ToMeUnmerge(torch.autograd.Function):
+    """
+    unmerge of bipartite_soft_matching_random2d, optionally followed by a residual connection, exported to ONNX
+    as a single ToMeUnmerge operation. It reuses the permutation and the matches computed for the merge.
+    The operation is implemented by the OpenVINO custom operations extension (modules/custom_operations).
+    """
+
+    @staticmethod
+    def symbolic(g, x, token_idx, dst_idx, residual):
+        inputs = [x, token_idx, dst_idx] + ([residual] if residual is not None else [])
+        return g.op("ToMeUnmerge", *inputs)
+
+    @staticmethod
+    def forward(ctx, x, token_idx, dst_idx, residual):
+        B, N, _ = token_idx.shape
+        C = x.shape[-1]
+        r = dst_idx.shape[1]
+
+        out = torch.zeros(B, N, C, device=x.device, dtype=x.dtype)
+        out.scatter_(dim=-2, index=token_idx[:, :r, :].expand(B, r, C), src=x.gather(dim=-2, index=dst_idx.expand(B, r, C)))
+        out.scatter_(dim=-2, index=token_idx[:, r:, :].expand(B, N - r, C), src=x)
+        return out if residual is None else out + residual
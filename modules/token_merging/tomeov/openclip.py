@@ -10,7 +10,7 @@ from .utils import isinstance_str, init_generator
 from timm.models.vision_transformer import Attention
 
 from .utils import parse_r
-from .merge import merge_wavg, merge_source, bipartite_soft_matching, bipartite_soft_matching_random2d
+from .merge import merge_wavg, merge_wavg_native, merge_source, bipartite_soft_matching, bipartite_soft_matching_random2d
 
 class ToMeResidualAttentionBlock(nn.Module):
     """
@@ -29,17 +29,27 @@ class ToMeResidualAttentionBlock(nn.Module):
         r = self._tome_info["r"].pop(0) 
         if r > 0:
             # Apply ToMe here
-            merge, _ = bipartite_soft_matching(
-                metric,
-                r,
-                self._tome_info["class_token"],
-                self._tome_info["distill_token"],
-            )
-            if self._tome_info["trace_source"]:
-                self._tome_info["source"] = merge_source(
-                    merge, x, self._tome_info["source"]
+            if self._tome_info["native_merge"] and not self._tome_info["trace_source"]:
+                x, self._tome_info["size"] = merge_wavg_native(
+                    metric,
+                    x,
+                    r,
+                    self._tome_info["class_token"],
+                    self._tome_info["distill_token"],
+                    self._tome_info["size"],
                 )
-            x, self._tome_info["size"] = merge_wavg(merge, x, self._tome_info["size"])
+            else:
+                merge, _ = bipartite_soft_matching(
+                    metric,
+                    r,
+                    self._tome_info["class_token"],
+                    self._tome_info["distill_token"],
+                )
+                if self._tome_info["trace_source"]:
+                    self._tome_info["source"] = merge_source(
+                        merge, x, self._tome_info["source"]
+                    )
+                x, self._tome_info["size"] = merge_wavg(merge, x, self._tome_info["size"])
 
         x = x + self.ls_2(self.mlp(self.ln_2(x)))
         return x
@@ -163,10 +173,13 @@ def make_tome_class(transformer_class):
 
 
 def patch_openclip(
-    model, ratio, trace_source: bool = False, prop_attn: bool = True
+    model, ratio, trace_source: bool = False, prop_attn: bool = True, native_merge: bool = False
 ):
     """
     Applies ToMe the OpenCLIP model.
+
+    With native_merge set to True, every merge is exported as a single ToMeMerge operation, which requires
+    the OpenVINO custom operations extension (modules/custom_operations) to run the model.
     """
     vision_model = model.visual
     ToMeVisionTransformer = make_tome_class(vision_model.__class__)
@@ -180,6 +193,7 @@ def patch_openclip(
         "source": None,
         "trace_source": trace_source,
         "prop_attn": prop_attn,
+        "native_merge": native_merge,
         "class_token": True,
         "distill_token": False,
     }
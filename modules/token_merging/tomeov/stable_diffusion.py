@@ -23,7 +23,7 @@ def compute_merge(x: torch.Tensor, tome_info: Dict[str, Any]) -> Tuple[Callable,
         # If the batch size is odd, then it's not possible for prompted and unprompted images to be in the same
         # batch, which causes artifacts with use_rand, so force it to be off.
         use_rand = False if x.shape[0] % 2 == 1 else args["use_rand"]
-        m, u = merge.bipartite_soft_matching_random2d(x, r)
+        m, u = merge.bipartite_soft_matching_random2d(x, r, args["native_unmerge"])
     else:
         m, u = (merge.do_nothing, merge.do_nothing)
 
@@ -34,6 +34,15 @@ def compute_merge(x: torch.Tensor, tome_info: Dict[str, Any]) -> Tuple[Callable,
     return m_a, m_c, m_m, u_a, u_c, u_m  # Okay this is probably not very good
 
 
+def unmerge_add(unmerge: Callable, x: torch.Tensor, residual: torch.Tensor) -> torch.Tensor:
+    """
+    Unmerges x and adds the residual. The native unmerge adds the residual while writing the unmerged tokens.
+    """
+    if unmerge is merge.do_nothing:
+        return x + residual
+    return unmerge(x, residual)
+
+
 def make_tome_block(block_class: Type[torch.nn.Module]) -> Type[torch.nn.Module]:
     """
     Make a patched class on the fly so we don't have to import any specific modules.
@@ -48,9 +57,9 @@ def make_tome_block(block_class: Type[torch.nn.Module]) -> Type[torch.nn.Module]
             m_a, m_c, m_m, u_a, u_c, u_m = compute_merge(x, self._tome_info)
 
             # This is where the meat of the computation happens
-            x = u_a(self.attn1(m_a(self.norm1(x)), context=context if self.disable_self_attn else None)) + x
-            x = u_c(self.attn2(m_c(self.norm2(x)), context=context)) + x
-            x = u_m(self.ff(m_m(self.norm3(x)))) + x
+            x = unmerge_add(u_a, self.attn1(m_a(self.norm1(x)), context=context if self.disable_self_attn else None), x)
+            x = unmerge_add(u_c, self.attn2(m_c(self.norm2(x)), context=context), x)
+            x = unmerge_add(u_m, self.ff(m_m(self.norm3(x))), x)
 
             return x
     
@@ -119,7 +128,7 @@ def make_diffusers_tome_block(block_class: Type[torch.nn.Module]) -> Type[torch.
                 attn_output = gate_msa.unsqueeze(1) * attn_output
 
             # (3) ToMe u_a
-            hidden_states = u_a(attn_output) + hidden_states
+            hidden_states = unmerge_add(u_a, attn_output, hidden_states)
 
             if self.attn2 is not None:
                 norm_hidden_states = (
@@ -136,7 +145,7 @@ def make_diffusers_tome_block(block_class: Type[torch.nn.Module]) -> Type[torch.
                     **cross_attention_kwargs,
                 )
                 # (5) ToMe u_c
-                hidden_states = u_c(attn_output) + hidden_states
+                hidden_states = unmerge_add(u_c, attn_output, hidden_states)
 
             # 3. Feed-forward
             norm_hidden_states = self.norm3(hidden_states)
@@ -153,7 +162,7 @@ def make_diffusers_tome_block(block_class: Type[torch.nn.Module]) -> Type[torch.
                 ff_output = gate_mlp.unsqueeze(1) * ff_output
 
             # (7) ToMe u_m
-            hidden_states = u_m(ff_output) + hidden_states
+            hidden_states = unmerge_add(u_m, ff_output, hidden_states)
 
             return hidden_states
 
@@ -177,7 +186,8 @@ def patch_stable_diffusion(
         use_rand: bool = True,
         merge_attn: bool = True,
         merge_crossattn: bool = False,
-        merge_mlp: bool = False):
+        merge_mlp: bool = False,
+        native_unmerge: bool = False):
     """
     Patches a stable diffusion model with ToMe.
     Apply this to the highest level stable diffusion object (i.e., it should have a .model.diffusion_model).
@@ -199,6 +209,8 @@ def patch_stable_diffusion(
      - merge_attn: Whether or not to merge tokens for attention (recommended).
      - merge_crossattn: Whether or not to merge tokens for cross attention (not recommended).
      - merge_mlp: Whether or not to merge tokens for the mlp layers (very not recommended).
+     - native_unmerge: Whether or not to export every unmerge and the following residual connection as a single
+                       ToMeUnmerge operation. The model then requires the OpenVINO custom operations extension.
     """
 
     # Make sure the module is not currently patched
@@ -226,7 +238,8 @@ def patch_stable_diffusion(
             "generator": None,
             "merge_attn": merge_attn,
             "merge_crossattn": merge_crossattn,
-            "merge_mlp": merge_mlp
+            "merge_mlp": merge_mlp,
+            "native_unmerge": native_unmerge
         }
     }
     hook_tome_model(diffusion_model)
@@ -7,7 +7,7 @@ import torch
 from timm.models.vision_transformer import Attention, Block, VisionTransformer
 
 from tomeov.utils import parse_r
-from .merge import merge_wavg, merge_source, bipartite_soft_matching, bipartite_soft_matching_random2d
+from .merge import merge_wavg, merge_wavg_native, merge_source, bipartite_soft_matching, bipartite_soft_matching_random2d
 
 
 
@@ -33,17 +33,27 @@ class ToMeBlock(Block):
         r = self._tome_info["r"].pop(0)
         if r > 0:
             # Apply ToMe here
-            merge, _ = bipartite_soft_matching(
-                metric,
-                r,
-                self._tome_info["class_token"],
-                self._tome_info["distill_token"],
-            )
-            if self._tome_info["trace_source"]:
-                self._tome_info["source"] = merge_source(
-                    merge, x, self._tome_info["source"]
+            if self._tome_info["native_merge"] and not self._tome_info["trace_source"]:
+                x, self._tome_info["size"] = merge_wavg_native(
+                    metric,
+                    x,
+                    r,
+                    self._tome_info["class_token"],
+                    self._tome_info["distill_token"],
+                    self._tome_info["size"],
                 )
-            x, self._tome_info["size"] = merge_wavg(merge, x, self._tome_info["size"])
+            else:
+                merge, _ = bipartite_soft_matching(
+                    metric,
+                    r,
+                    self._tome_info["class_token"],
+                    self._tome_info["distill_token"],
+                )
+                if self._tome_info["trace_source"]:
+                    self._tome_info["source"] = merge_source(
+                        merge, x, self._tome_info["source"]
+                    )
+                x, self._tome_info["size"] = merge_wavg(merge, x, self._tome_info["size"])
             # print(self._tome_info["size"])
 
         x = x + self._drop_path2(self.mlp(self.norm2(x)))
@@ -108,7 +118,8 @@ def make_tome_class(transformer_class):
 
 
 def patch_timm(
-    model: VisionTransformer, r: int = 0, trace_source: bool = False, prop_attn: bool = True
+    model: VisionTransformer, r: int = 0, trace_source: bool = False, prop_attn: bool = True,
+    native_merge: bool = False
 ):
     """
     Applies ToMe to this transformer. Afterward, set r using model.r.
@@ -118,6 +129,10 @@ def patch_timm(
 
     For proportional attention, set prop_attn to True. This is only necessary when evaluating models off
     the shelf. For trianing and for evaluating MAE models off the self set this to be False.
+
+    With native_merge set to True, every merge is exported as a single ToMeMerge operation instead of
+    the matching and gather/scatter subgraph. Running such a model requires the OpenVINO custom operations
+    extension (modules/custom_operations). Source tracing is not supported by the operation.
     """
     ToMeVisionTransformer = make_tome_class(model.__class__)
 
@@ -129,6 +144,7 @@ def patch_timm(
         "source": None,
         "trace_source": trace_source,
         "prop_attn": prop_attn,
+        "native_merge": native_merge,
         "class_token": model.cls_token is not None,
         "distill_token": False,
     }